@@ -0,0 +1,156 @@
+#include "approximate_search.hpp"
+#include "longest_common_extension.hpp"
+#include "lz_factorization.hpp"
+#include "suffix_tree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Throughput of the algorithms against their naive reference implementations.
+// Built with -DENABLE_BENCHMARK=ON; numbers are only meaningful for optimized builds.
+namespace {
+
+	// Best wall clock time of a few runs, in seconds
+	template <class Fn>
+	double measure(Fn const& fn, int runs = 3) {
+		double best = 0;
+		for (int run = 0; run < runs; ++run) {
+			auto const start = std::chrono::steady_clock::now();
+			fn();
+			double const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			best = run == 0 ? elapsed : std::min(best, elapsed);
+		}
+		return best;
+	}
+
+	std::string randomText(size_t length, int alphabet, unsigned seed) {
+		std::mt19937 generator(seed);
+		std::uniform_int_distribution<int> letter(0, alphabet - 1);
+		std::string text(length, ' ');
+		for (auto& c : text)
+			c = static_cast<char>('a' + letter(generator));
+		return text;
+	}
+
+	std::string periodicText(size_t length, int period) {
+		std::string text(length, ' ');
+		for (size_t i = 0; i < length; ++i)
+			text[i] = static_cast<char>('a' + i % period);
+		return text;
+	}
+
+	// Random sentences over a small vocabulary, the kind of repetition found in logs
+	std::string wordText(size_t length, unsigned seed) {
+		char const* const words[] = { "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "error", "request", "timeout", "retry" };
+		std::mt19937 generator(seed);
+		std::uniform_int_distribution<int> word(0, static_cast<int>(std::size(words)) - 1);
+		std::string text;
+		while (text.size() < length)
+			text.append(words[word(generator)]).push_back(' ');
+		text.resize(length);
+		return text;
+	}
+
+	void report(char const* name, char const* algorithm, size_t length, size_t count, double seconds) {
+		std::printf("%-14s %-30s %9zu %12.2f %10zu\n", name, algorithm, length, length / seconds / 1e6, count);
+	}
+
+	// The naive scan is quadratic, so it runs on a shorter prefix of the same text
+	void benchmarkLzFactorization() {
+		size_t const fastLength = 1 << 18, naiveLength = 1 << 14;
+		struct Input {
+			char const* m_name;
+			std::string m_text;
+		};
+		Input const inputs[] = {
+			{ "random/2", randomText(fastLength, 2, 1) },
+			{ "random/4", randomText(fastLength, 4, 2) },
+			{ "period/8", periodicText(fastLength, 8) },
+			{ "words", wordText(fastLength, 3) },
+		};
+
+		std::printf("%-14s %-30s %9s %12s %10s\n", "lz77", "", "bytes", "MB/s", "phrases");
+		for (auto const& [name, text] : inputs) {
+			std::string const prefix = text.substr(0, naiveLength);
+			auto run = [name = name](std::string const& algorithm, std::string const& input, auto const& factorize, int runs) {
+				size_t phrases = 0;
+				double const seconds = measure([&] { phrases = factorize(input).size(); }, runs);
+				report(name, algorithm.c_str(), input.size(), phrases, seconds);
+				std::fflush(stdout);
+			};
+			run("lzFactorization", text, [](std::string const& s) { return jag::algo::lzFactorization(s); }, 3);
+			run("bruteForceLzFactorization", prefix, [](std::string const& s) { return jag::algo::bruteForceLzFactorization(s); }, 1);
+			for (int window : { 64, 4096 }) {
+				std::string const suffix = " w=" + std::to_string(window);
+				run("lzFactorization" + suffix, text, [window](std::string const& s) { return jag::algo::lzFactorization(s, window); }, 3);
+				run("bruteForceLzFactorization" + suffix, prefix, [window](std::string const& s) { return jag::algo::bruteForceLzFactorization(s, window); }, 1);
+			}
+		}
+	}
+
+	// Text searched per second, summed over a batch of patterns sampled from the text. Indexes are built once, outside the timings.
+	// On random text the naive scan gives up after a few characters per window; LCE jumps pay off once windows match for long.
+	void benchmarkApproximateSearch() {
+		size_t const length = 1 << 16, patternCount = 8;
+		struct Input {
+			char const* m_name;
+			std::string m_text;
+			size_t m_patternLength;
+		};
+		Input const inputs[] = {
+			{ "random/4", randomText(length, 4, 4), 16 },
+			{ "words", wordText(length, 5), 64 },
+			{ "period/8", periodicText(length, 8), 256 },
+		};
+
+		std::printf("\n%-14s %-30s %9s %12s %10s\n", "approximate", "", "bytes", "MB/s", "matches");
+		for (auto const& [name, text, patternLength] : inputs) {
+			std::vector<std::string> patterns;
+			for (size_t i = 0; i < patternCount; ++i)
+				patterns.push_back(text.substr(i * (length / patternCount), patternLength));
+
+			std::unique_ptr<jag::algo::LongestCommonExtension> lce; // over text followed by every pattern
+			double const lceSeconds = measure([&] {
+				std::string str = text;
+				for (auto const& pattern : patterns)
+					str += pattern;
+				lce = std::make_unique<jag::algo::LongestCommonExtension>(str);
+			}, 1);
+			std::unique_ptr<jag::algo::SuffixTree> tree;
+			double const treeSeconds = measure([&] { tree = std::make_unique<jag::algo::SuffixTree>(text); }, 1);
+			report(name, "LongestCommonExtension", length + patternLength * patternCount, 0, lceSeconds);
+			report(name, "SuffixTree", length, 0, treeSeconds);
+
+			for (int k = 0; k <= 3; ++k) {
+				std::string const label = std::string(name) + " k=" + std::to_string(k);
+				auto run = [&label, &patterns](char const* algorithm, auto const& search) {
+					size_t matches = 0;
+					double const seconds = measure([&] {
+						matches = 0;
+						for (size_t i = 0; i < patterns.size(); ++i)
+							matches += search(i).size();
+					});
+					report(label.c_str(), algorithm, length * patterns.size(), matches, seconds);
+					std::fflush(stdout);
+				};
+				int const m = static_cast<int>(patternLength);
+				run("kMismatchSearch", [&](size_t i) { return jag::algo::kMismatchSearch(*lce, static_cast<int>(length), static_cast<int>(length) + m * static_cast<int>(i), m, k); });
+				run("bruteForceMismatchSearch", [&](size_t i) { return jag::algo::bruteForceMismatchSearch(text, patterns[i], k); });
+				run("kEditSearch", [&](size_t i) { return jag::algo::kEditSearch(*tree, patterns[i], k); });
+			}
+		}
+	}
+
+} // namespace
+
+int main() {
+	benchmarkLzFactorization();
+	benchmarkApproximateSearch();
+	return 0;
+}
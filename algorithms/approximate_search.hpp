@@ -0,0 +1,159 @@
+#ifndef JAG_ALGO_APPROXIMATE_SEARCH_HPP
+#define JAG_ALGO_APPROXIMATE_SEARCH_HPP
+
+#include "longest_common_extension.hpp"
+#include "suffix_tree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace jag::algo {
+
+	// Reference implementation: every window compared character by character. O(nm)
+	inline std::vector<int> bruteForceMismatchSearch(std::string const& text, std::string const& pattern, int k) {
+		std::vector<int> positions;
+		int const m = static_cast<int>(pattern.size());
+		for (int pos = 0; pos + m <= static_cast<int>(text.size()); ++pos) {
+			int mismatches = 0;
+			for (int j = 0; j < m && mismatches <= k; ++j)
+				mismatches += text[pos + j] != pattern[j];
+			if (mismatches <= k)
+				positions.push_back(pos);
+		}
+		return positions;
+	}
+
+	// Start positions of the windows of text at Hamming distance at most k from the pattern stored at patternStart.
+	// lce indexes text, at position 0, followed by patterns: with O(1) longest common extension queries each window is
+	// checked by jumping from one mismatch to the next, at most k + 1 jumps, so the search is O(nk) on top of building the index.
+	// Extensions are capped by what is left of the window, they never run past the window nor past the pattern, which keeps
+	// the answer exact without needing a separator between text and patterns.
+	inline std::vector<int> kMismatchSearch(LongestCommonExtension const& lce, int textLength, int patternStart, int patternLength, int k) {
+		assert(textLength <= patternStart && patternStart + patternLength <= lce.size());
+		std::vector<int> positions;
+		for (int pos = 0; pos + patternLength <= textLength; ++pos) {
+			int mismatches = 0;
+			for (int j = 0; j < patternLength && mismatches <= k;) {
+				j += std::min(lce(pos + j, patternStart + j), patternLength - j);
+				if (j < patternLength) {
+					++mismatches;
+					++j;
+				}
+			}
+			if (mismatches <= k)
+				positions.push_back(pos);
+		}
+		return positions;
+	}
+
+	// lce built over text + pattern
+	inline std::vector<int> kMismatchSearch(LongestCommonExtension const& lce, int textLength, int patternLength, int k) {
+		assert(lce.size() == textLength + patternLength);
+		return kMismatchSearch(lce, textLength, textLength, patternLength, k);
+	}
+
+	// One search per pattern, sharing a single index over text followed by every pattern
+	inline std::vector<std::vector<int>> kMismatchSearch(std::string const& text, std::vector<std::string> const& patterns, int k) {
+		std::string str = text;
+		for (auto const& pattern : patterns)
+			str += pattern;
+		LongestCommonExtension const lce(str);
+
+		std::vector<std::vector<int>> positions;
+		positions.reserve(patterns.size());
+		int patternStart = static_cast<int>(text.size());
+		for (auto const& pattern : patterns) {
+			int const patternLength = static_cast<int>(pattern.size());
+			positions.push_back(kMismatchSearch(lce, static_cast<int>(text.size()), patternStart, patternLength, k));
+			patternStart += patternLength;
+		}
+		return positions;
+	}
+
+	inline std::vector<int> kMismatchSearch(std::string const& text, std::string const& pattern, int k) {
+		if (pattern.size() > text.size())
+			return {};
+		return kMismatchSearch(LongestCommonExtension(text + pattern), static_cast<int>(text.size()), static_cast<int>(pattern.size()), k);
+	}
+
+	// Start positions of the substrings of the tree's text at edit distance at most k from pattern, sorted.
+	// Walks the suffix tree depth first carrying one dynamic programming column (pattern against the path label), shared by
+	// every suffix below the current edge: a branch is abandoned as soon as the whole column exceeds k, and once the last
+	// entry is within k every leaf below is an occurrence. Work depends on the part of the tree within distance k of the
+	// pattern rather than on the length of the text.
+	inline std::vector<int> kEditSearch(SuffixTree const& st, std::string const& pattern, int k) {
+		int const m = static_cast<int>(pattern.size());
+		int const textLength = static_cast<int>(st.m_data.size()); // includes the terminator
+		std::vector<int> positions;
+
+		auto collectLeaves = [&](int node, int depth) {
+			std::vector<std::pair<int, int>> stack{ { node, depth } };
+			while (!stack.empty()) {
+				auto [current, currentDepth] = stack.back();
+				stack.pop_back();
+				if (st[current].isLeaf()) {
+					if (textLength - currentDepth < textLength - 1) // the suffix made of the terminator alone is not a position
+						positions.push_back(textLength - currentDepth);
+					continue;
+				}
+				for (auto const& edge : st[current])
+					stack.emplace_back(edge.second, currentDepth + st[edge.second].edgeLength());
+			}
+		};
+
+		std::vector<int> root(m + 1);
+		for (int j = 0; j <= m; ++j)
+			root[j] = j;
+		if (root[m] <= k) { // the empty string already matches, so does every position
+			collectLeaves(0, 0);
+			std::sort(positions.begin(), positions.end());
+			return positions;
+		}
+
+		struct Frame {
+			int m_node, m_depth;
+			std::vector<int> m_column;
+		};
+		std::vector<Frame> stack{ { 0, 0, root } };
+		while (!stack.empty()) {
+			Frame frame = std::move(stack.back());
+			stack.pop_back();
+			for (auto const& edge : st[frame.m_node]) {
+				int const child = edge.second;
+				SuffixTree::Node const& node = st[child];
+				std::vector<int> column = frame.m_column;
+				bool matched = false, pruned = false;
+				for (int i = node.m_start; i < node.m_start + node.edgeLength() && !matched && !pruned; ++i) {
+					if (i == textLength - 1) { // the terminator matches nothing
+						pruned = true;
+						break;
+					}
+					int diagonal = column[0];
+					column[0] += 1;
+					int best = column[0];
+					for (int j = 1; j <= m; ++j) {
+						int const substitution = diagonal + (pattern[j - 1] != st.m_data[i]);
+						diagonal = column[j];
+						column[j] = std::min({ substitution, column[j] + 1, column[j - 1] + 1 });
+						best = std::min(best, column[j]);
+					}
+					matched = column[m] <= k;
+					pruned = best > k;
+				}
+				int const childDepth = frame.m_depth + node.edgeLength();
+				if (matched)
+					collectLeaves(child, childDepth);
+				else if (!pruned && !node.isLeaf())
+					stack.push_back(Frame{ child, childDepth, std::move(column) });
+			}
+		}
+		std::sort(positions.begin(), positions.end());
+		return positions;
+	}
+
+} // namespace jag::algo
+
+#endif // JAG_ALGO_APPROXIMATE_SEARCH_HPP
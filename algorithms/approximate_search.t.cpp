@@ -0,0 +1,82 @@
+#include "approximate_search.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+using jag::algo::bruteForceMismatchSearch;
+using jag::algo::kEditSearch;
+using jag::algo::kMismatchSearch;
+using jag::algo::SuffixTree;
+using ::testing::ElementsAre;
+
+namespace {
+	// Start positions of the substrings within edit distance k of pattern, one full dynamic programming table per start
+	std::vector<int> bruteForceEditSearch(std::string const& text, std::string const& pattern, int k) {
+		std::vector<int> positions;
+		int const m = static_cast<int>(pattern.size());
+		for (int pos = 0; pos < static_cast<int>(text.size()); ++pos) {
+			std::vector<int> column(m + 1);
+			for (int j = 0; j <= m; ++j)
+				column[j] = j;
+			bool found = column[m] <= k;
+			for (int i = pos; i < static_cast<int>(text.size()) && !found; ++i) {
+				std::vector<int> next(m + 1, column[0] + 1);
+				for (int j = 1; j <= m; ++j)
+					next[j] = std::min({ column[j - 1] + (pattern[j - 1] != text[i]), column[j] + 1, next[j - 1] + 1 });
+				column.swap(next);
+				found = column[m] <= k;
+			}
+			if (found)
+				positions.push_back(pos);
+		}
+		return positions;
+	}
+
+	std::string const longInput = "aacbbabbabbbbbaaaaaaabbbbcacacbcabaccaabbbcaaabbccccbbbcbccccbbcaabaaabcbaacbcbaccaaaccbccbcaacbaccbaacbbabbabbbbb";
+}
+
+TEST(ApproximateSearch, kMismatchSearch)
+{
+	EXPECT_THAT(kMismatchSearch("abcabcddd", "abd", 0), ElementsAre());
+	EXPECT_THAT(kMismatchSearch("abcabcddd", "abd", 1), ElementsAre(0, 3));
+	EXPECT_THAT(kMismatchSearch("abcabcddd", "abd", 2), ElementsAre(0, 3, 4, 5, 6));
+	EXPECT_THAT(kMismatchSearch("banana", "ana", 0), ElementsAre(1, 3));
+	EXPECT_THAT(kMismatchSearch("ab", "abc", 3), ElementsAre());
+
+	for (std::string const pattern : { "abba", "cbca", "aaaaa", "bcabaccaab", "c" })
+		for (int k : { 0, 1, 2, 3 })
+			EXPECT_EQ(bruteForceMismatchSearch(longInput, pattern, k), kMismatchSearch(longInput, pattern, k)) << pattern << " " << k;
+
+	// Embedded '\0' characters are ordinary characters, nothing may rely on them to stop a comparison
+	EXPECT_THAT(kMismatchSearch(std::string("a\0b\0a\0b", 7), std::string("\0b", 2), 0), ElementsAre(1, 5));
+	std::string const nulInput("a\0b\0a\0b\0a\0b\0a\0b\0a\0b\0\0\0", 22);
+	for (std::string const pattern : { std::string("\0b", 2), std::string("\0", 1), std::string("b\0\0", 3) })
+		for (int k : { 0, 1 })
+			EXPECT_EQ(bruteForceMismatchSearch(nulInput, pattern, k), kMismatchSearch(nulInput, pattern, k)) << k;
+}
+
+TEST(ApproximateSearch, kMismatchSearchBatch)
+{
+	std::vector<std::string> const patterns = { "abba", "cbca", "aaaaa", "bcabaccaab", "c", "", longInput + "a", "bbbbb" };
+	for (int k : { 0, 1, 2, 3 }) {
+		auto const positions = kMismatchSearch(longInput, patterns, k);
+		ASSERT_EQ(patterns.size(), positions.size());
+		for (size_t i = 0; i < patterns.size(); ++i)
+			EXPECT_EQ(bruteForceMismatchSearch(longInput, patterns[i], k), positions[i]) << patterns[i] << " " << k;
+	}
+	EXPECT_TRUE(kMismatchSearch("abc", std::vector<std::string>{}, 1).empty());
+}
+
+TEST(ApproximateSearch, kEditSearch)
+{
+	SuffixTree st("abcabcddd");
+	EXPECT_THAT(kEditSearch(st, "abd", 0), ElementsAre());
+	EXPECT_THAT(kEditSearch(st, "abcd", 0), ElementsAre(3));
+	EXPECT_THAT(kEditSearch(st, "abd", 1), ElementsAre(0, 3)); // "ab" twice, "bcd" needs two edits
+	EXPECT_THAT(kEditSearch(st, "ab", 2), ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8));
+
+	SuffixTree longTree(longInput);
+	for (std::string const pattern : { "abba", "cbca", "aaaaa", "bcabaccaab", "c" })
+		for (int k : { 0, 1, 2, 3 })
+			EXPECT_EQ(bruteForceEditSearch(longInput, pattern, k), kEditSearch(longTree, pattern, k)) << pattern << " " << k;
+}
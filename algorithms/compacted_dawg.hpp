@@ -0,0 +1,139 @@
+#ifndef JAG_ALGO_COMPACTED_DAWG_HPP
+#define JAG_ALGO_COMPACTED_DAWG_HPP
+
+#include "suffix_automaton.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jag::algo {
+
+    // Compacted directed acyclic word graph (CDAWG).
+    // Built from a finalized SuffixAutomaton by removing every state with a single outgoing edge that is neither the root
+    // nor final: the chain of transitions through such states becomes one edge labelled by a slice [m_start, m_start + m_length)
+    // of the text, the same way SuffixTree::Node references the text with m_start/m_end.
+    // Edges are kept in a sorted vector per node rather than a hash map, which is where most of the savings come from.
+    class CompactedDawg {
+    public:
+        struct Edge {
+            char m_character;
+            int m_target;
+            int m_start, m_length;
+        };
+
+        struct Node {
+            std::vector<Edge> m_edges;
+            int m_length; // length of the longest string reaching this node
+            int m_size;   // number of occurrences of the strings reaching this node
+            bool m_final;
+
+            Edge const* find(char c) const noexcept {
+                auto it = std::lower_bound(m_edges.begin(), m_edges.end(), c, [](Edge const& edge, char ch) noexcept {return edge.m_character < ch; });
+                return (it != m_edges.end() && it->m_character == c) ? &*it : nullptr;
+            }
+        };
+
+        CompactedDawg(std::string const& s) : CompactedDawg(SuffixAutomaton(s), s) {}
+
+        // automaton must be the finalized automaton of s
+        CompactedDawg(SuffixAutomaton const& automaton, std::string const& s) : m_data(s) {
+            auto const& states = automaton.states();
+            int const count = static_cast<int>(states.size());
+
+            // Nodes that survive compaction
+            std::vector<int> nodeOf(count, -1);
+            for (int i = 0; i < count; ++i) {
+                if (i == 0 || states[i].m_final || states[i].m_edges.size() != 1) {
+                    nodeOf[i] = static_cast<int>(m_nodes.size());
+                    m_nodes.push_back(Node{ {}, states[i].m_length, states[i].m_size, states[i].m_final });
+                }
+            }
+
+            // For every state, the surviving state its unary chain leads to and how many transitions that takes.
+            // Chains are shared between incoming paths, so they are memoized rather than walked once per edge.
+            std::vector<int> dest(count, -1), dist(count, 0);
+            std::vector<int> chain;
+            auto resolve = [&](int state) {
+                while (nodeOf[state] == -1 && dest[state] == -1) {
+                    chain.push_back(state);
+                    state = states[state].m_edges.begin()->second;
+                }
+                int target = nodeOf[state] != -1 ? state : dest[state];
+                int steps = nodeOf[state] != -1 ? 0 : dist[state];
+                for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+                    dest[*it] = target;
+                    dist[*it] = ++steps;
+                }
+                chain.clear();
+                return std::make_pair(target, steps);
+            };
+
+            for (int i = 0; i < count; ++i) {
+                if (nodeOf[i] == -1)
+                    continue;
+                Node& node = m_nodes[nodeOf[i]];
+                node.m_edges.reserve(states[i].m_edges.size());
+                for (auto const& [c, next] : states[i].m_edges) {
+                    auto [target, steps] = resolve(next);
+                    int length = steps + 1;
+                    // Every string reaching target ends at its first occurrence, so the label is the text right before it
+                    node.m_edges.push_back(Edge{ c, nodeOf[target], states[target].m_firstPos - length + 1, length });
+                }
+                std::sort(node.m_edges.begin(), node.m_edges.end(), [](Edge const& lhs, Edge const& rhs) noexcept {return lhs.m_character < rhs.m_character; });
+            }
+        }
+
+        // Index of the node at (or right below, when s ends in the middle of an edge) the end of s. -1 if s is not a substring
+        int traverse(std::string const& s, int nodeIndex = 0) const {
+            return locate(s, nodeIndex).first;
+        }
+
+        bool contains(std::string const& s) const { return traverse(s) != -1; }
+        int count(std::string const& s) const { int index = traverse(s); return index == -1 ? 0 : m_nodes[index].m_size; }
+        bool isSuffix(std::string const& s) const {
+            auto [index, remaining] = locate(s, 0);
+            return index != -1 && remaining == 0 && m_nodes[index].m_final;
+        }
+
+        bool empty() const noexcept { return m_nodes.size() < 2; }
+        size_t size() const noexcept { return m_nodes.size(); }
+        size_t edgeCount() const noexcept {
+            size_t edges(0);
+            for (auto const& node : m_nodes)
+                edges += node.m_edges.size();
+            return edges;
+        }
+        Node const& operator[](size_t i) const { return m_nodes[i]; }
+        std::vector<Node> const& nodes() const noexcept { return m_nodes; }
+        std::string_view label(Edge const& edge) const noexcept { return std::string_view(m_data).substr(edge.m_start, edge.m_length); }
+
+    private:
+        // Node reached and the number of label characters still left on the edge leading to it
+        std::pair<int, int> locate(std::string const& s, int nodeIndex) const {
+            size_t pos = 0;
+            int remaining = 0;
+            while (pos < s.size()) {
+                Edge const* edge = m_nodes[nodeIndex].find(s[pos]);
+                if (edge == nullptr)
+                    return std::make_pair(-1, 0);
+                int matched = 1;
+                while (matched < edge->m_length && pos + matched < s.size()) {
+                    if (m_data[edge->m_start + matched] != s[pos + matched])
+                        return std::make_pair(-1, 0);
+                    ++matched;
+                }
+                pos += matched;
+                remaining = edge->m_length - matched;
+                nodeIndex = edge->m_target;
+            }
+            return std::make_pair(nodeIndex, remaining);
+        }
+
+        std::vector<Node> m_nodes;
+        std::string m_data;
+    };
+} // namespace jag::algo
+#endif //JAG_ALGO_COMPACTED_DAWG_HPP
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "compacted_dawg.hpp"
+#include "suffix_automaton.hpp"
+#include "suffix_tree.hpp"
+
+using jag::algo::CompactedDawg;
+using jag::algo::SuffixAutomaton;
+using jag::algo::SuffixTree;
+
+TEST(CompactedDawg, Constructor) {
+	CompactedDawg cdawg("abcbc");
+	// root, the sink, and the final node of {"bc", "c"}
+	EXPECT_EQ(3, cdawg.size());
+	EXPECT_EQ(4, cdawg.edgeCount());
+	for (auto const& node : cdawg.nodes())
+		for (auto const& edge : node.m_edges)
+			EXPECT_EQ(edge.m_character, cdawg.label(edge).front());
+
+	EXPECT_TRUE(CompactedDawg("").empty());
+}
+
+TEST(CompactedDawg, contains) {
+	CompactedDawg cdawg("abcbc");
+	EXPECT_TRUE(cdawg.contains("cbc"));
+	EXPECT_TRUE(cdawg.contains("abcbc"));
+	EXPECT_TRUE(cdawg.contains(""));
+	EXPECT_FALSE(cdawg.contains("bb"));
+	EXPECT_FALSE(cdawg.contains("abcbcb"));
+
+	EXPECT_TRUE(cdawg.isSuffix("bc"));
+	EXPECT_TRUE(cdawg.isSuffix("cbc"));
+	EXPECT_FALSE(cdawg.isSuffix("cb"));
+}
+
+TEST(CompactedDawg, EncountersCount) {
+	CompactedDawg cdawg("abcbcbcd");
+	EXPECT_EQ(1, cdawg.count("ab"));
+	EXPECT_EQ(3, cdawg.count("bc"));
+	EXPECT_EQ(2, cdawg.count("cb"));
+	EXPECT_EQ(2, cdawg.count("bcb"));
+	EXPECT_EQ(1, cdawg.count("bcd"));
+	EXPECT_EQ(1, cdawg.count("cd"));
+	EXPECT_EQ(0, cdawg.count("dd"));
+}
+
+TEST(CompactedDawg, matchesAutomaton) {
+	for (std::string const str : { "banana", "mississippi", "abcabxabcd", "aaaaaaaa", "GATAGACA" }) {
+		SuffixAutomaton sa(str);
+		CompactedDawg cdawg(sa, str);
+		for (size_t i = 0; i < str.size(); ++i)
+			for (size_t len = 1; i + len <= str.size(); ++len) {
+				std::string const sub = str.substr(i, len);
+				EXPECT_EQ(sa.count(sub), cdawg.count(sub)) << str << " " << sub;
+				EXPECT_EQ(sa.isSuffix(sub), cdawg.isSuffix(sub)) << str << " " << sub;
+				EXPECT_FALSE(cdawg.contains(sub + "#"));
+			}
+	}
+}
+
+TEST(CompactedDawg, repetitive) {
+	std::string str;
+	for (int i = 0; i < 50; ++i)
+		str += "the quick brown fox jumps over the lazy dog ";
+	SuffixAutomaton sa(str);
+	CompactedDawg cdawg(sa, str);
+	SuffixTree st(str);
+
+	EXPECT_LT(5 * cdawg.size(), sa.size());
+	EXPECT_LT(5 * cdawg.size(), st.size());
+	// Nodes alone could hide the edges, which hold most of the memory: every transition of the automaton, and every edge of
+	// the tree (one per node but the root), against a single edge per non branching chain of transitions
+	size_t transitions = 0;
+	for (auto const& state : sa.states())
+		transitions += state.m_edges.size();
+	EXPECT_LT(20 * cdawg.edgeCount(), transitions);
+	EXPECT_LT(20 * cdawg.edgeCount(), st.size() - 1);
+	EXPECT_EQ(50, cdawg.count("lazy dog"));
+	EXPECT_EQ(49, cdawg.count("dog the"));
+}
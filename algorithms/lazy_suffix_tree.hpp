@@ -0,0 +1,165 @@
+#ifndef JAG_ALGO_LAZY_SUFFIX_TREE_HPP
+#define JAG_ALGO_LAZY_SUFFIX_TREE_HPP
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace jag::algo {
+
+	// Suffix tree built top-down on demand (write-only, top-down construction, Giegerich, Kurtz & Stoye).
+	// Every node owns a range of m_suffixes: the suffixes below it. A node is expanded (its children grouped by the next
+	// character and their edge labels measured) only the first time a query descends into it, so building costs nothing
+	// and total work is bounded by what queries actually touch. Children of a node are stored contiguously.
+	// Queries share a reader lock and upgrade to a writer lock for the rare expansion, so the tree can be queried from
+	// several threads at once.
+	class LazySuffixTree {
+	public:
+		struct Node {
+			int m_start, m_length;          // edge label, m_data[m_start, m_start + m_length)
+			int m_depth;                    // length of the path label at the bottom of the edge
+			int m_first, m_last;            // suffixes below this node, m_suffixes[m_first, m_last)
+			int m_firstChild, m_childCount; // m_firstChild is -1 until the node is expanded
+
+			bool isLeaf() const noexcept { return m_last - m_first == 1; }
+			bool isExpanded() const noexcept { return isLeaf() || m_firstChild != -1; }
+			int count() const noexcept { return m_last - m_first; }
+		};
+
+		LazySuffixTree(std::string const& str)
+			: m_data(str)
+			, m_suffixes(str.size())
+		{
+			std::iota(m_suffixes.begin(), m_suffixes.end(), 0);
+			m_nodes.push_back(Node{ 0, 0, 0, 0, static_cast<int>(str.size()), -1, 0 });
+		}
+
+		LazySuffixTree(LazySuffixTree const&) = delete;
+		LazySuffixTree& operator=(LazySuffixTree const&) = delete;
+
+		bool contains(std::string const& str) const { return locate(str) != -1; }
+
+		int count(std::string const& str) const {
+			std::shared_lock lock(m_mutex);
+			int node = locate(str, lock);
+			return node == -1 ? 0 : m_nodes[node].count();
+		}
+
+		// Start positions of every occurrence of str, in no particular order
+		std::vector<int> find(std::string const& str) const {
+			std::shared_lock lock(m_mutex);
+			int node = locate(str, lock);
+			if (node == -1)
+				return {};
+			return std::vector<int>(m_suffixes.begin() + m_nodes[node].m_first, m_suffixes.begin() + m_nodes[node].m_last);
+		}
+
+		// Number of nodes materialized so far
+		size_t size() const {
+			std::shared_lock lock(m_mutex);
+			return m_nodes.size();
+		}
+
+		std::string const& str() const noexcept { return m_data; }
+
+	private:
+		int locate(std::string const& str) const {
+			std::shared_lock lock(m_mutex);
+			return locate(str, lock);
+		}
+
+		// Node whose subtree holds all the occurrences of str, or -1. The lock is held (shared) on return
+		int locate(std::string const& str, std::shared_lock<std::shared_mutex>& lock) const {
+			int nodeIndex = 0;
+			size_t pos = 0;
+			while (pos < str.size()) {
+				if (m_nodes[nodeIndex].isLeaf()) {
+					// A single suffix left, whatever remains of str must follow in the text
+					Node const& leaf = m_nodes[nodeIndex];
+					std::string_view const rest = std::string_view(str).substr(pos);
+					return std::string_view(m_data).substr(m_suffixes[leaf.m_first] + leaf.m_depth, rest.size()) == rest ? nodeIndex : -1;
+				}
+				if (!m_nodes[nodeIndex].isExpanded()) {
+					lock.unlock();
+					{
+						std::unique_lock writer(m_mutex);
+						expand(nodeIndex);
+					}
+					lock.lock();
+				}
+				Node const& node = m_nodes[nodeIndex];
+				auto first = m_nodes.begin() + node.m_firstChild;
+				auto last = first + node.m_childCount;
+				auto child = std::find_if(first, last, [&](Node const& n) noexcept {return n.m_length > 0 && m_data[n.m_start] == str[pos]; });
+				if (child == last)
+					return -1;
+				std::string_view const label = std::string_view(m_data).substr(child->m_start, child->m_length);
+				std::string_view const rest = std::string_view(str).substr(pos, label.size());
+				if (label.substr(0, rest.size()) != rest)
+					return -1;
+				pos += rest.size();
+				nodeIndex = static_cast<int>(child - m_nodes.begin());
+			}
+			return nodeIndex;
+		}
+
+		// Groups the suffixes of an unexpanded node by their next character and appends one child per group
+		void expand(int nodeIndex) const {
+			if (m_nodes[nodeIndex].isExpanded())
+				return; // another thread got here first
+			int const len = static_cast<int>(m_data.size());
+			int const depth = m_nodes[nodeIndex].m_depth;
+			int const first = m_nodes[nodeIndex].m_first;
+			int const last = m_nodes[nodeIndex].m_last;
+
+			// Counting pass over the next character, a suffix that ends right here going first: O(k + sigma) for k suffixes
+			auto key = [&](int suffix) noexcept { return suffix + depth < len ? static_cast<unsigned char>(m_data[suffix + depth]) + 1 : 0; };
+			std::array<int, 258> bucket{}; // offsets from first: bucket[b] starts bucket b, then ends it once scattered
+			for (int i = first; i < last; ++i)
+				++bucket[key(m_suffixes[i]) + 1];
+			std::partial_sum(bucket.begin(), bucket.end(), bucket.begin());
+			m_scratch.resize(last - first);
+			for (int i = first; i < last; ++i)
+				m_scratch[bucket[key(m_suffixes[i])]++] = m_suffixes[i];
+			auto begin = m_suffixes.begin();
+			std::copy(m_scratch.begin(), m_scratch.end(), begin + first);
+
+			int const firstChild = static_cast<int>(m_nodes.size());
+			for (int b = 0, group = first; b < 257; ++b) {
+				int const end = first + bucket[b];
+				if (end == group)
+					continue;
+
+				int const suffix = m_suffixes[group];
+				int length;
+				if (end - group == 1)
+					length = len - suffix - depth; // leaf, the label runs to the end of the text
+				else {
+					// Longest prefix shared by the whole group, it is at least the character they were grouped by
+					length = 1;
+					while (std::all_of(begin + group + 1, begin + end, [&](int other) noexcept {
+						return other + depth + length < len && suffix + depth + length < len && m_data[other + depth + length] == m_data[suffix + depth + length]; }))
+						++length;
+				}
+				m_nodes.push_back(Node{ suffix + depth, length, depth + length, group, end, -1, 0 });
+				group = end;
+			}
+			m_nodes[nodeIndex].m_firstChild = firstChild;
+			m_nodes[nodeIndex].m_childCount = static_cast<int>(m_nodes.size()) - firstChild;
+		}
+
+		std::string m_data;
+		mutable std::vector<int> m_suffixes;
+		mutable std::vector<int> m_scratch; // expand() buffer, under the writer lock
+		mutable std::vector<Node> m_nodes;
+		mutable std::shared_mutex m_mutex;
+	};
+
+} // end of namespace jag::algo
+
+#endif // JAG_ALGO_LAZY_SUFFIX_TREE_HPP
@@ -0,0 +1,75 @@
+#include "lazy_suffix_tree.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <thread>
+
+using jag::algo::LazySuffixTree;
+using ::testing::UnorderedElementsAre;
+
+namespace {
+	int bruteForceCount(std::string const& str, std::string const& sub) {
+		int count = 0;
+		for (size_t pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + 1))
+			++count;
+		return count;
+	}
+}
+
+TEST(LazySuffixTree, Constructor) {
+	LazySuffixTree st("mississippi");
+	EXPECT_EQ(1, st.size()); // nothing but the root until the first query
+	EXPECT_TRUE(st.contains("ssi"));
+	EXPECT_LT(1, st.size());
+	size_t const expanded = st.size();
+	EXPECT_TRUE(st.contains("ssi"));
+	EXPECT_EQ(expanded, st.size());
+}
+
+TEST(LazySuffixTree, contains) {
+	LazySuffixTree st("axabg");
+	EXPECT_TRUE(st.contains("xabg"));
+	EXPECT_TRUE(st.contains(""));
+	EXPECT_FALSE(st.contains("xabt"));
+	EXPECT_FALSE(st.contains("xabgx"));
+
+	EXPECT_TRUE(LazySuffixTree("a").contains("a"));
+	EXPECT_FALSE(LazySuffixTree("a").contains("b"));
+	EXPECT_FALSE(LazySuffixTree("").contains("a"));
+}
+
+TEST(LazySuffixTree, count) {
+	LazySuffixTree st("abcbcbcd");
+	EXPECT_EQ(1, st.count("ab"));
+	EXPECT_EQ(3, st.count("bc"));
+	EXPECT_EQ(2, st.count("cb"));
+	EXPECT_EQ(2, st.count("bcb"));
+	EXPECT_EQ(1, st.count("bcd"));
+	EXPECT_EQ(0, st.count("dd"));
+	EXPECT_THAT(st.find("bc"), UnorderedElementsAre(1, 3, 5));
+
+	for (std::string const str : { "aaaaaa", "mississippi", "abcabxabcd", "banana" }) {
+		LazySuffixTree lazy(str);
+		for (size_t i = 0; i < str.size(); ++i)
+			for (size_t len = 1; i + len <= str.size(); ++len)
+				EXPECT_EQ(bruteForceCount(str, str.substr(i, len)), lazy.count(str.substr(i, len))) << str << " " << str.substr(i, len);
+	}
+}
+
+TEST(LazySuffixTree, concurrentQueries) {
+	std::string const str = "aacbbabbabbbbbaaaaaaabbbbcacacbcabaccaabbbcaaabbccccbbbcbccccbbcaabaaabcbaacbcbaccaaaccbccbcaacbaccbaacbbabbabbbbb";
+	LazySuffixTree lazy(str);
+	std::vector<std::thread> threads;
+	std::vector<int> errors(4, 0);
+	for (int t = 0; t < 4; ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = t; i < str.size(); i += 4)
+				for (size_t len = 1; len < 8 && i + len <= str.size(); ++len)
+					if (lazy.count(str.substr(i, len)) != bruteForceCount(str, str.substr(i, len)))
+						++errors[t];
+		});
+	for (auto& thread : threads)
+		thread.join();
+	EXPECT_EQ(std::vector<int>(4, 0), errors);
+}
@@ -26,11 +26,12 @@ namespace jag::algo {
 		for (int i = 0; i < n; ++i) {
 			if (prevSuffix[i] == -1) {
 				lcpWithPrev[i] = 0;
+				lcpLength = 0;
 				continue;
 			}
 
-			// Calculate the longest common prefix length
-			while (str[i + lcpLength] == str[prevSuffix[i] + lcpLength]) {
+			// Calculate the longest common prefix length. Bounded explicitly: the text may contain '\0' itself
+			while (i + lcpLength < n && prevSuffix[i] + lcpLength < n && str[i + lcpLength] == str[prevSuffix[i] + lcpLength]) {
 				++lcpLength;
 			}
 			lcpWithPrev[i] = lcpLength; // Store the LCP length with the previous suffix
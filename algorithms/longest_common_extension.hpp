@@ -0,0 +1,61 @@
+#ifndef JAG_ALGO_LONGEST_COMMON_EXTENSION_HPP
+#define JAG_ALGO_LONGEST_COMMON_EXTENSION_HPP
+
+#include "lcp_array.hpp"
+#include "suffix_array.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace jag::algo {
+
+	// Longest common extension queries: length of the longest common prefix of the suffixes starting at i and j, in O(1).
+	// The answer is the minimum of the LCP array between the ranks of i and j, looked up in a sparse table
+	// (O(n log n) memory) built over lcpArray().
+	class LongestCommonExtension {
+	public:
+		LongestCommonExtension(std::string const& str)
+			: m_length(static_cast<int>(str.size()))
+			, m_rank(str.size())
+		{
+			if (str.empty())
+				return;
+			std::vector<int> const sa = suffixArray(str);
+			for (int r = 0; r < m_length; ++r)
+				m_rank[sa[r]] = r;
+
+			m_table.push_back(lcpArray(str, sa));
+			for (int width = 1; 2 * width <= m_length; width *= 2) {
+				std::vector<int> const& prev = m_table.back();
+				std::vector<int> next(m_length - 2 * width + 1);
+				for (int i = 0; i < static_cast<int>(next.size()); ++i)
+					next[i] = std::min(prev[i], prev[i + width]);
+				m_table.push_back(std::move(next));
+			}
+		}
+
+		int operator()(int i, int j) const {
+			if (i == j)
+				return m_length - i;
+			if (i >= m_length || j >= m_length)
+				return 0;
+			int lo = std::min(m_rank[i], m_rank[j]) + 1;
+			int hi = std::max(m_rank[i], m_rank[j]) + 1;
+			int level = static_cast<int>(std::bit_width(static_cast<unsigned>(hi - lo))) - 1;
+			return std::min(m_table[level][lo], m_table[level][hi - (1 << level)]);
+		}
+
+		int size() const noexcept { return m_length; }
+
+	private:
+		int m_length;
+		std::vector<int> m_rank;
+		std::vector<std::vector<int>> m_table; // m_table[k][i] is the minimum of lcp[i, i + 2^k)
+	};
+
+} // namespace jag::algo
+
+#endif // JAG_ALGO_LONGEST_COMMON_EXTENSION_HPP
@@ -0,0 +1,29 @@
+#include "longest_common_extension.hpp"
+
+#include <gtest/gtest.h>
+
+using jag::algo::LongestCommonExtension;
+
+TEST(Algorithms, longestCommonExtension)
+{
+	LongestCommonExtension lce("abcabcddd");
+	EXPECT_EQ(3, lce(0, 3));
+	EXPECT_EQ(0, lce(0, 1));
+	EXPECT_EQ(2, lce(1, 4));
+	EXPECT_EQ(1, lce(6, 8));
+	EXPECT_EQ(9, lce(0, 0));
+	EXPECT_EQ(0, lce(0, 9));
+
+	for (std::string const str : { "aaaaaa", "banana", "mississippi", "ABRACADABRA$",
+		"aacbbabbabbbbbaaaaaaabbbbcacacbcabaccaabbbcaaabbccccbbbcbccccbbcaabaaabcbaacbcbaccaaaccbccbcaacbaccbaacbbabbabbbbb" }) {
+		LongestCommonExtension lce(str);
+		int const n = static_cast<int>(str.size());
+		for (int i = 0; i < n; ++i)
+			for (int j = 0; j < n; ++j) {
+				int expected = 0;
+				while (i + expected < n && j + expected < n && str[i + expected] == str[j + expected])
+					++expected;
+				EXPECT_EQ(expected, lce(i, j)) << str << " " << i << " " << j;
+			}
+	}
+}
@@ -0,0 +1,247 @@
+#ifndef JAG_ALGO_LZ_FACTORIZATION_HPP
+#define JAG_ALGO_LZ_FACTORIZATION_HPP
+
+#include "suffix_array.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace jag::algo {
+
+	// One LZ77 phrase: either a copy of m_length characters starting at the earlier position m_source
+	// (source and phrase may overlap), or a single literal character when m_length is 0.
+	struct LzFactor {
+		int m_source;
+		int m_length;
+		char m_literal;
+
+		bool isLiteral() const noexcept { return m_length == 0; }
+		int size() const noexcept { return isLiteral() ? 1 : m_length; }
+		bool operator==(LzFactor const&) const = default;
+	};
+
+	namespace detail {
+		inline int commonPrefix(std::string const& str, int lhs, int rhs) noexcept {
+			int len = static_cast<int>(str.size());
+			int l = 0;
+			while (rhs + l < len && str[lhs + l] == str[rhs + l])
+				++l;
+			return l;
+		}
+
+		inline LzFactor makeFactor(std::string const& str, int pos, int source, int length) noexcept {
+			return length == 0 ? LzFactor{ -1, 0, str[pos] } : LzFactor{ source, length, 0 };
+		}
+
+		// Set of integers in [0, n): one bit per value, plus a bit per non empty 64-bit word on the level above, up to a single word.
+		// Insertion, removal, successor and predecessor all take O(log_64 n) word operations, without any allocation
+		class BitSet64 {
+		public:
+			explicit BitSet64(int n) {
+				size_t words = static_cast<size_t>(n);
+				do {
+					words = (words + 63) / 64;
+					m_levels.emplace_back(words, 0);
+				} while (words > 1);
+			}
+
+			void insert(int x) noexcept {
+				for (auto& level : m_levels) {
+					std::uint64_t& word = level[x >> 6];
+					bool const wasEmpty = word == 0;
+					word |= std::uint64_t{ 1 } << (x & 63);
+					if (!wasEmpty)
+						return;
+					x >>= 6;
+				}
+			}
+
+			void erase(int x) noexcept {
+				for (auto& level : m_levels) {
+					std::uint64_t& word = level[x >> 6];
+					word &= ~(std::uint64_t{ 1 } << (x & 63));
+					if (word != 0)
+						return;
+					x >>= 6;
+				}
+			}
+
+			// Smallest element >= x, -1 if none
+			int next(int x) const noexcept {
+				size_t level = 0;
+				for (;; ++level) {
+					if (level == m_levels.size() || static_cast<size_t>(x >> 6) >= m_levels[level].size())
+						return -1;
+					std::uint64_t const word = m_levels[level][x >> 6] & (~std::uint64_t{ 0 } << (x & 63));
+					if (word != 0) {
+						x = (x & ~63) | std::countr_zero(word);
+						break;
+					}
+					x = (x >> 6) + 1;
+				}
+				while (level-- > 0)
+					x = (x << 6) | std::countr_zero(m_levels[level][x]);
+				return x;
+			}
+
+			// Largest element <= x, -1 if none
+			int prev(int x) const noexcept {
+				size_t level = 0;
+				for (;; ++level) {
+					if (level == m_levels.size() || x < 0)
+						return -1;
+					std::uint64_t const word = m_levels[level][x >> 6] & (~std::uint64_t{ 0 } >> (63 - (x & 63)));
+					if (word != 0) {
+						x = (x & ~63) | (63 - std::countl_zero(word));
+						break;
+					}
+					x = (x >> 6) - 1;
+				}
+				while (level-- > 0)
+					x = (x << 6) | (63 - std::countl_zero(m_levels[level][x]));
+				return x;
+			}
+
+		private:
+			std::vector<std::vector<std::uint64_t>> m_levels;
+		};
+	} // namespace detail
+
+	// Reference implementation: for every phrase, scan all earlier positions (optionally only the last window ones). O(n^2)
+	inline std::vector<LzFactor> bruteForceLzFactorization(std::string const& str, int window = std::numeric_limits<int>::max()) {
+		std::vector<LzFactor> factors;
+		int len = static_cast<int>(str.size());
+		for (int pos = 0; pos < len;) {
+			int source = -1, length = 0;
+			for (int j = std::max(0, pos - std::min(pos, window)); j < pos; ++j) {
+				int l = detail::commonPrefix(str, j, pos);
+				if (l > length) {
+					length = l;
+					source = j;
+				}
+			}
+			factors.push_back(detail::makeFactor(str, pos, source, length));
+			pos += factors.back().size();
+		}
+		return factors;
+	}
+
+	// Linear time LZ77 factorization.
+	// For every text position i, the longest previous factor starts at one of its two nearest neighbours in suffix array order
+	// among the positions smaller than i (previous/next smaller value of i in the suffix array).
+	// Both are computed in one stack pass over the suffix array; comparing a phrase against its two candidates costs at most
+	// twice the phrase length, so the factorization itself is O(n) as well.
+	template <class OutputIt>
+	OutputIt lzFactorize(std::string const& str, OutputIt out) {
+		if (str.empty())
+			return out;
+		int len = static_cast<int>(str.size());
+		std::vector<int> const sa = suffixArray(str);
+		std::vector<int> psv(len, -1), nsv(len, -1);
+		std::vector<int> stack;
+		stack.reserve(len);
+		for (int pos : sa) {
+			while (!stack.empty() && stack.back() > pos) {
+				nsv[stack.back()] = pos;
+				stack.pop_back();
+			}
+			psv[pos] = stack.empty() ? -1 : stack.back();
+			stack.push_back(pos);
+		}
+
+		for (int pos = 0; pos < len;) {
+			int source = -1, length = 0;
+			for (int candidate : { psv[pos], nsv[pos] }) {
+				if (candidate == -1)
+					continue;
+				int l = detail::commonPrefix(str, candidate, pos);
+				if (l > length) {
+					length = l;
+					source = candidate;
+				}
+			}
+			LzFactor const factor = detail::makeFactor(str, pos, source, length);
+			*out++ = factor;
+			pos += factor.size();
+		}
+		return out;
+	}
+
+	// Windowed variant: sources must start at most window characters before the phrase.
+	// The longest previous factor is then the predecessor or the successor of the phrase start in suffix array order among
+	// the positions inside the window. Those positions are kept as a set of ranks that slides along with the parse (every
+	// position enters and leaves it once), a bit per rank over 64-ary levels, so each phrase costs O(log_64 n) plus its own
+	// length: O(n log_64 n) on top of building the suffix array.
+	template <class OutputIt>
+	OutputIt lzFactorize(std::string const& str, int window, OutputIt out) {
+		if (str.empty())
+			return out;
+		int len = static_cast<int>(str.size());
+		std::vector<int> const sa = suffixArray(str);
+		std::vector<int> rank(len);
+		for (int r = 0; r < len; ++r)
+			rank[sa[r]] = r;
+
+		detail::BitSet64 ranks(len); // ranks of the positions in [first, last)
+		int first = 0, last = 0;
+		for (int pos = 0; pos < len;) {
+			int const lowest = pos - std::min(pos, window);
+			for (; first < std::min(lowest, last); ++first)
+				ranks.erase(rank[first]);
+			first = lowest;
+			for (last = std::max(last, lowest); last < pos; ++last)
+				ranks.insert(rank[last]);
+
+			int source = -1, length = 0;
+			auto consider = [&](int r) {
+				if (r == -1)
+					return;
+				int l = detail::commonPrefix(str, sa[r], pos);
+				if (l > length) {
+					length = l;
+					source = sa[r];
+				}
+			};
+			consider(ranks.next(rank[pos]));
+			consider(ranks.prev(rank[pos]));
+
+			LzFactor const factor = detail::makeFactor(str, pos, source, length);
+			*out++ = factor;
+			pos += factor.size();
+		}
+		return out;
+	}
+
+	inline std::vector<LzFactor> lzFactorization(std::string const& str) {
+		std::vector<LzFactor> factors;
+		lzFactorize(str, std::back_inserter(factors));
+		return factors;
+	}
+
+	inline std::vector<LzFactor> lzFactorization(std::string const& str, int window) {
+		std::vector<LzFactor> factors;
+		lzFactorize(str, window, std::back_inserter(factors));
+		return factors;
+	}
+
+	inline std::string lzDecode(std::vector<LzFactor> const& factors) {
+		std::string str;
+		for (LzFactor const& factor : factors) {
+			if (factor.isLiteral())
+				str.push_back(factor.m_literal);
+			else // Copy one character at a time, the source may overlap the phrase
+				for (int i = 0; i < factor.m_length; ++i)
+					str.push_back(str[factor.m_source + i]);
+		}
+		return str;
+	}
+
+} // namespace jag::algo
+
+#endif // JAG_ALGO_LZ_FACTORIZATION_HPP
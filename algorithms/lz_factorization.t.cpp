@@ -0,0 +1,62 @@
+#include "lz_factorization.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+using jag::algo::bruteForceLzFactorization;
+using jag::algo::LzFactor;
+using jag::algo::lzDecode;
+using jag::algo::lzFactorization;
+using ::testing::ElementsAre;
+
+namespace {
+	std::vector<int> phraseLengths(std::vector<LzFactor> const& factors) {
+		std::vector<int> lengths;
+		for (auto const& factor : factors)
+			lengths.push_back(factor.size());
+		return lengths;
+	}
+}
+
+TEST(LzFactorization, bruteForce)
+{
+	EXPECT_THAT(bruteForceLzFactorization("abababc"), ElementsAre(LzFactor{ -1, 0, 'a' }, LzFactor{ -1, 0, 'b' }, LzFactor{ 0, 4, 0 }, LzFactor{ -1, 0, 'c' }));
+	EXPECT_THAT(bruteForceLzFactorization("aaaaaa"), ElementsAre(LzFactor{ -1, 0, 'a' }, LzFactor{ 0, 5, 0 }));
+	EXPECT_TRUE(bruteForceLzFactorization("").empty());
+}
+
+TEST(LzFactorization, lzFactorization)
+{
+	EXPECT_THAT(lzFactorization("abababc"), ElementsAre(LzFactor{ -1, 0, 'a' }, LzFactor{ -1, 0, 'b' }, LzFactor{ 0, 4, 0 }, LzFactor{ -1, 0, 'c' }));
+	EXPECT_THAT(lzFactorization("aaaaaa"), ElementsAre(LzFactor{ -1, 0, 'a' }, LzFactor{ 0, 5, 0 }));
+	EXPECT_TRUE(lzFactorization("").empty());
+
+	for (std::string const str : { "banana", "ABRACADABRA$", "GATAGACA$", "abcabcddd", "mississippi",
+		"aacbbabbabbbbbaaaaaaabbbbcacacbcabaccaabbbcaaabbccccbbbcbccccbbcaabaaabcbaacbcbaccaaaccbccbcaacbaccbaacbbabbabbbbb" }) {
+		auto const factors = lzFactorization(str);
+		EXPECT_EQ(phraseLengths(bruteForceLzFactorization(str)), phraseLengths(factors)) << str;
+		EXPECT_EQ(str, lzDecode(factors));
+	}
+}
+
+TEST(LzFactorization, window)
+{
+	// With a window of 2, "ab" can only be copied from the two characters right before it
+	EXPECT_THAT(lzFactorization("abcab", 2), ElementsAre(LzFactor{ -1, 0, 'a' }, LzFactor{ -1, 0, 'b' }, LzFactor{ -1, 0, 'c' }, LzFactor{ -1, 0, 'a' }, LzFactor{ -1, 0, 'b' }));
+	EXPECT_THAT(lzFactorization("abcab", 3), ElementsAre(LzFactor{ -1, 0, 'a' }, LzFactor{ -1, 0, 'b' }, LzFactor{ -1, 0, 'c' }, LzFactor{ 0, 2, 0 }));
+
+	std::string const str = "aacbbabbabbbbbaaaaaaabbbbcacacbcabaccaabbbcaaabbccccbbbcbccccbbcaabaaabcbaacbcbaccaaaccbccbcaacbaccbaacbbabbabbbbb";
+	for (int window : { 1, 2, 3, 5, 8, 16, 1000 }) {
+		auto const factors = lzFactorization(str, window);
+		EXPECT_EQ(phraseLengths(bruteForceLzFactorization(str, window)), phraseLengths(factors)) << window;
+		EXPECT_EQ(str, lzDecode(factors));
+		for (int pos = 0; auto const& factor : factors) {
+			if (!factor.isLiteral()) {
+				EXPECT_LE(pos - factor.m_source, window);
+			}
+			pos += factor.size();
+		}
+	}
+	EXPECT_EQ(phraseLengths(lzFactorization(str)), phraseLengths(lzFactorization(str, 1000)));
+	EXPECT_TRUE(lzFactorization("", 4).empty());
+}
@@ -0,0 +1,267 @@
+#ifndef JAG_ALGO_SLIDING_SUFFIX_AUTOMATON_HPP
+#define JAG_ALGO_SLIDING_SUFFIX_AUTOMATON_HPP
+
+#include "suffix_automaton.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace jag::algo {
+
+    namespace detail {
+        // Number of (possibly overlapping) occurrences of a non empty pattern in text, Knuth-Morris-Pratt in O(|text| + |pattern|)
+        inline int countOccurrences(std::string const& text, std::string const& pattern) {
+            std::vector<size_t> border(pattern.size(), 0);
+            for (size_t i = 1, k = 0; i < pattern.size(); ++i) {
+                while (k > 0 && pattern[i] != pattern[k])
+                    k = border[k - 1];
+                if (pattern[i] == pattern[k])
+                    ++k;
+                border[i] = k;
+            }
+            int count = 0;
+            for (size_t i = 0, k = 0; i < text.size(); ++i) {
+                while (k > 0 && text[i] != pattern[k])
+                    k = border[k - 1];
+                if (text[i] == pattern[k])
+                    ++k;
+                if (k == pattern.size()) {
+                    ++count;
+                    k = border[k - 1];
+                }
+            }
+            return count;
+        }
+    } // namespace detail
+
+    // Suffix automaton over the last window() characters of an unbounded stream.
+    // Two automata are fed in parallel, the younger one started window() characters after the older one. Queries go to the
+    // older one, which indexes between window() and 2 * window() - 1 trailing characters. When the younger automaton reaches
+    // window() characters the older one expires and a fresh automaton starts, so memory stays bounded and no rebuild ever
+    // happens. The expired states are released a few at a time on the following appends, to keep freeing them out of the hot path.
+    // Answers are exact for the window: every automaton keeps a link-cut tree over its suffix links holding, for every state,
+    // how many of its end positions are still inside the window and the last of them. An append adds one along the path of
+    // the new state and a character leaving the window removes its own, both in O(log window) amortized, so count() never
+    // waits for an aggregation. The occurrences that end inside the window but start before it are then found directly in
+    // the few characters around its start, in O(|s|).
+    // Queries restructure the link-cut trees, they are serialized by a mutex. append() must not run concurrently with them.
+    class SlidingSuffixAutomaton {
+    public:
+        explicit SlidingSuffixAutomaton(size_t window)
+            : m_window(window < 1 ? 1 : window)
+            , m_position(0)
+            , m_recent(2 * m_window, '\0')
+            , m_older(0, m_window)
+            , m_younger(m_window, m_window)
+        {}
+
+        SlidingSuffixAutomaton& append(char c) {
+            m_recent[m_position % m_recent.size()] = c;
+            m_older.append(c);
+            if (m_position >= m_younger.m_start)
+                m_younger.append(c);
+            ++m_position;
+
+            if (m_younger.length() == m_window) {
+                m_expired = std::move(m_older.m_automaton.m_states);
+                m_older = std::move(m_younger);
+                m_younger = Epoch(m_older.m_start + m_window, m_window);
+            }
+            else if (m_position > m_window)
+                m_older.expire(m_position - m_window - 1 - m_older.m_start); // the character that just left the window
+            // Expiries are window() appends apart and the expired automaton covered 2 * window() characters, so at most 4 * window() states
+            for (int i = 0; i < 4 && !m_expired.empty(); ++i)
+                m_expired.pop_back();
+            return *this;
+        }
+
+        SlidingSuffixAutomaton& append(std::string const& s) {
+            for (auto c : s)
+                append(c);
+            return *this;
+        }
+
+        bool contains(std::string const& s) const {
+            if (s.size() > m_window)
+                return false;
+            std::lock_guard lock(m_mutex);
+            int const state = m_older.m_automaton.traverse(s);
+            // The last occurrence has to start inside the window
+            return state != -1 && m_older.m_start + static_cast<size_t>(m_older.last(state) + 1) >= windowStart() + s.size();
+        }
+
+        int count(std::string const& s) const {
+            if (s.size() > m_window)
+                return 0;
+            std::lock_guard lock(m_mutex);
+            int const state = m_older.m_automaton.traverse(s);
+            if (state == -1)
+                return 0;
+            int count = m_older.count(state); // occurrences ending inside the window
+            size_t const start = windowStart();
+            if (s.size() > 1 && start > m_older.m_start) {
+                // Minus those starting before it, all within s.size() - 1 characters of its start
+                size_t const first = start - std::min(start - m_older.m_start, s.size() - 1);
+                size_t const last = std::min(m_position, start + s.size() - 1);
+                std::string straddling;
+                for (size_t pos = first; pos < last; ++pos)
+                    straddling.push_back(m_recent[pos % m_recent.size()]);
+                count -= detail::countOccurrences(straddling, s);
+            }
+            return count;
+        }
+
+        size_t window() const noexcept { return m_window; }
+        // Number of trailing characters currently indexed, between window() and 2 * window() - 1 once the stream is long enough.
+        // Only the last window() of them are reported by queries
+        size_t coverage() const noexcept { return m_older.length(); }
+        SuffixAutomaton const& automaton() const noexcept { return m_older.m_automaton; }
+
+    private:
+        // An automaton and the link-cut tree over its suffix links, node i standing for state i
+        struct Epoch {
+            struct Node {
+                int m_child[2] = { -1, -1 };
+                int m_parent = -1;            // parent in its splay tree, or path-parent for the root of a splay tree
+                int m_count = 0, m_last = -1; // end positions inside the window, last end position
+                int m_add = 0, m_assign = -1; // pending for the splay subtree
+            };
+
+            // An automaton fed 2 * window - 1 characters has fewer than 4 * window states, none of the buffers ever grows
+            Epoch(size_t start, size_t window) : m_start(start), m_nodes(1) {
+                m_automaton.m_states.reserve(4 * window);
+                m_nodes.reserve(4 * window);
+                m_prefixStates.reserve(2 * window);
+            }
+
+            size_t length() const noexcept { return m_prefixStates.size(); }
+
+            void append(char c) {
+                int const pos = static_cast<int>(length());
+                m_automaton.append(c);
+                auto const& states = m_automaton.m_states;
+                int const curr = m_automaton.m_last;
+                m_nodes.resize(states.size());
+                if (int const q = m_automaton.m_split; q != -1) {
+                    // The clone takes the place of q under its former suffix link, with the same end positions
+                    int const clone = static_cast<int>(states.size()) - 1;
+                    splay(q);
+                    m_nodes[clone].m_count = m_nodes[q].m_count;
+                    m_nodes[clone].m_last = m_nodes[q].m_last;
+                    cut(q);
+                    link(clone, states[clone].m_link);
+                    link(q, clone);
+                }
+                link(curr, states[curr].m_link);
+                update(curr, 1, pos);
+                m_prefixStates.push_back(curr);
+            }
+
+            // The character at pos left the window
+            void expire(size_t pos) { update(m_prefixStates[pos], -1, -1); }
+
+            int count(int state) const { splay(state); return m_nodes[state].m_count; }
+            int last(int state) const { splay(state); return m_nodes[state].m_last; }
+
+            bool isSplayRoot(int x) const noexcept {
+                int const parent = m_nodes[x].m_parent;
+                return parent == -1 || (m_nodes[parent].m_child[0] != x && m_nodes[parent].m_child[1] != x);
+            }
+
+            void apply(int x, int add, int assign) const noexcept {
+                if (x == -1)
+                    return;
+                m_nodes[x].m_count += add;
+                m_nodes[x].m_add += add;
+                if (assign != -1)
+                    m_nodes[x].m_last = m_nodes[x].m_assign = assign;
+            }
+
+            void push(int x) const noexcept {
+                apply(m_nodes[x].m_child[0], m_nodes[x].m_add, m_nodes[x].m_assign);
+                apply(m_nodes[x].m_child[1], m_nodes[x].m_add, m_nodes[x].m_assign);
+                m_nodes[x].m_add = 0;
+                m_nodes[x].m_assign = -1;
+            }
+
+            void rotate(int x) const noexcept {
+                int const parent = m_nodes[x].m_parent, grandParent = m_nodes[parent].m_parent;
+                int const side = m_nodes[parent].m_child[1] == x ? 1 : 0;
+                int const moved = m_nodes[x].m_child[side ^ 1];
+                if (!isSplayRoot(parent))
+                    m_nodes[grandParent].m_child[m_nodes[grandParent].m_child[1] == parent ? 1 : 0] = x;
+                m_nodes[x].m_parent = grandParent;
+                m_nodes[x].m_child[side ^ 1] = parent;
+                m_nodes[parent].m_parent = x;
+                m_nodes[parent].m_child[side] = moved;
+                if (moved != -1)
+                    m_nodes[moved].m_parent = parent;
+            }
+
+            void splay(int x) const {
+                // Pending updates are pushed from the root of the splay tree down to x first
+                for (int y = x;; y = m_nodes[y].m_parent) {
+                    m_path.push_back(y);
+                    if (isSplayRoot(y))
+                        break;
+                }
+                for (auto it = m_path.rbegin(); it != m_path.rend(); ++it)
+                    push(*it);
+                m_path.clear();
+
+                while (!isSplayRoot(x)) {
+                    int const parent = m_nodes[x].m_parent;
+                    if (!isSplayRoot(parent)) {
+                        int const grandParent = m_nodes[parent].m_parent;
+                        bool const sameSide = (m_nodes[grandParent].m_child[1] == parent) == (m_nodes[parent].m_child[1] == x);
+                        rotate(sameSide ? parent : x);
+                    }
+                    rotate(x);
+                }
+            }
+
+            // Makes the path from the root to x the splay tree rooted at x
+            void access(int x) const {
+                for (int below = -1, y = x; y != -1; below = y, y = m_nodes[y].m_parent) {
+                    splay(y);
+                    m_nodes[y].m_child[1] = below;
+                }
+                splay(x);
+            }
+
+            // x has to be the root of its tree, with no splay children (fresh, or just cut)
+            void link(int x, int parent) { m_nodes[x].m_parent = parent; }
+
+            void cut(int x) {
+                access(x);
+                m_nodes[m_nodes[x].m_child[0]].m_parent = -1;
+                m_nodes[x].m_child[0] = -1;
+            }
+
+            // Adds add to the count of every state from x up to the root and, unless last is -1, sets their last end position
+            void update(int x, int add, int last) {
+                access(x);
+                apply(x, add, last);
+            }
+
+            size_t m_start; // stream position of the first character
+            SuffixAutomaton m_automaton;
+            mutable std::vector<Node> m_nodes;
+            mutable std::vector<int> m_path;
+            std::vector<int> m_prefixStates; // state created by the append of every character
+        };
+
+        size_t windowStart() const noexcept { return m_position - std::min(m_position, m_window); }
+
+        size_t m_window;
+        size_t m_position;     // characters appended so far
+        std::string m_recent;  // last 2 * window() characters, character pos at pos % (2 * window())
+        Epoch m_older, m_younger;
+        std::vector<SuffixAutomaton::State> m_expired;
+        mutable std::mutex m_mutex;
+    };
+} // namespace jag::algo
+#endif //JAG_ALGO_SLIDING_SUFFIX_AUTOMATON_HPP
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "sliding_suffix_automaton.hpp"
+#include "suffix_automaton.hpp"
+
+using jag::algo::SlidingSuffixAutomaton;
+using jag::algo::SuffixAutomaton;
+
+TEST(SlidingSuffixAutomaton, window) {
+	SlidingSuffixAutomaton sa(4);
+	EXPECT_EQ(0, sa.coverage());
+	sa.append("abc");
+	EXPECT_EQ(3, sa.coverage());
+	sa.append("defg");
+	EXPECT_EQ(4, sa.window());
+	EXPECT_EQ(7, sa.coverage());
+	EXPECT_FALSE(sa.contains("abc")); // Still indexed, but no longer in the window
+	EXPECT_EQ(0, sa.count("abc"));
+	EXPECT_FALSE(sa.contains("cd")); // Straddles the start of the window
+	EXPECT_EQ(0, sa.count("cd"));
+	EXPECT_TRUE(sa.contains("defg"));
+	sa.append('h'); // The older epoch expires, only "efgh" is left
+	EXPECT_EQ(4, sa.coverage());
+	EXPECT_TRUE(sa.contains("efgh"));
+	EXPECT_FALSE(sa.contains("d"));
+	EXPECT_FALSE(sa.contains("defgh"));
+}
+
+TEST(SlidingSuffixAutomaton, straddlingOccurrences) {
+	SlidingSuffixAutomaton sa(5);
+	sa.append("abababa"); // window "ababa", "ab" also occurs twice before it
+	EXPECT_EQ(2, sa.count("ab"));
+	EXPECT_EQ(2, sa.count("ba"));
+	EXPECT_EQ(2, sa.count("aba"));
+	EXPECT_EQ(1, sa.count("ababa"));
+	EXPECT_EQ(3, sa.count("a"));
+	EXPECT_FALSE(sa.contains("bababa"));
+}
+
+TEST(SlidingSuffixAutomaton, EncountersCount) {
+	SlidingSuffixAutomaton sa(8);
+	sa.append("abcbcbcd");
+	EXPECT_EQ(1, sa.count("ab"));
+	EXPECT_EQ(3, sa.count("bc"));
+	EXPECT_EQ(2, sa.count("bcb"));
+	sa.append("xxxxxxxx"); // "abcbcbcd" expires
+	EXPECT_EQ(0, sa.count("bc"));
+	EXPECT_EQ(7, sa.count("xx"));
+	sa.append("bc"); // "xxxxxxbc"
+	EXPECT_EQ(1, sa.count("bc"));
+	EXPECT_EQ(5, sa.count("xx"));
+}
+
+TEST(SlidingSuffixAutomaton, matchesAutomaton) {
+	std::string const stream = "aacbbabbabbbbbaaaaaaabbbbcacacbcabaccaabbbcaaabbccccbbbcbccccbbcaabaaabcbaacbcbaccaaaccbccbcaacbaccbaacbbabbabbbbb";
+	for (size_t window : { 1, 3, 10, 16 }) {
+		SlidingSuffixAutomaton sliding(window);
+		for (size_t end = 1; end <= stream.size(); ++end) {
+			sliding.append(stream[end - 1]);
+			ASSERT_GE(sliding.coverage(), std::min(end, window));
+			ASSERT_LT(sliding.coverage(), 2 * window);
+
+			std::string const tail = stream.substr(end - std::min(end, window), std::min(end, window));
+			SuffixAutomaton expected(tail);
+			for (std::string const pattern : { "a", "b", "c", "ab", "bb", "cc", "abc", "bbb", "cab", "aaaa", "abbab", "bbbbb", "cbccccbbca" }) {
+				EXPECT_EQ(expected.contains(pattern), sliding.contains(pattern)) << tail << " " << pattern;
+				EXPECT_EQ(expected.contains(pattern) ? expected.count(pattern) : 0, sliding.count(pattern)) << tail << " " << pattern;
+			}
+		}
+	}
+}
+
+TEST(SlidingSuffixAutomaton, longStream) {
+	// Binary text from a linear congruential generator: many clones and long suffix link paths
+	SlidingSuffixAutomaton sliding(37);
+	std::string stream;
+	unsigned seed = 12345;
+	for (int i = 0; i < 3000; ++i) {
+		seed = seed * 1103515245 + 12345;
+		stream.push_back((seed >> 16) % 3 == 0 ? 'b' : 'a');
+		sliding.append(stream.back());
+		if (i % 7 != 0)
+			continue;
+		std::string const tail = stream.substr(stream.size() - std::min<size_t>(stream.size(), 37));
+		for (size_t len = 1; len <= 6; ++len)
+			for (size_t pos = 0; pos + len <= stream.size() && pos < 80; pos += 5) {
+				std::string const pattern = stream.substr(stream.size() - pos - len, len);
+				int expected = 0;
+				for (size_t at = tail.find(pattern); at != std::string::npos; at = tail.find(pattern, at + 1))
+					++expected;
+				ASSERT_EQ(expected, sliding.count(pattern)) << i << " " << pattern;
+				ASSERT_EQ(expected > 0, sliding.contains(pattern)) << i << " " << pattern;
+			}
+	}
+}
@@ -0,0 +1,161 @@
+#ifndef JAG_ALGO_SPARSE_SUFFIX_ARRAY_HPP
+#define JAG_ALGO_SPARSE_SUFFIX_ARRAY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace jag::algo {
+
+	namespace detail {
+		// Karp-Rabin fingerprints of every prefix of a string, modulo the Mersenne prime 2^61 - 1.
+		// Any substring's fingerprint is available in O(1), so the longest common extension of two suffixes is found by
+		// binary search in O(log n), whatever its length. Equal fingerprints are trusted (Monte Carlo). The base is drawn at
+		// random for every table, so whatever the input, two different substrings of length at most n collide with
+		// probability at most n / 2^61 (their difference is a polynomial of degree at most n in the base).
+		// Two 64 bit words per character: 16n bytes.
+		class KarpRabin {
+		public:
+			KarpRabin(std::string const& str)
+				: m_str(str)
+				, m_prefix(str.size() + 1, 0)
+				, m_power(str.size() + 1, 1)
+			{
+				std::random_device seed;
+				std::uint64_t const base = std::uniform_int_distribution<std::uint64_t>(256, kModulus - 1)(seed);
+				for (size_t i = 0; i < str.size(); ++i) {
+					m_prefix[i + 1] = reduce(multiply(m_prefix[i], base) + static_cast<unsigned char>(str[i]) + 1);
+					m_power[i + 1] = multiply(m_power[i], base);
+				}
+			}
+
+			// Fingerprint of str[pos, pos + len)
+			std::uint64_t operator()(int pos, int len) const noexcept {
+				return reduce(m_prefix[pos + len] + kModulus - multiply(m_prefix[pos], m_power[len]));
+			}
+
+			// Length of the longest common prefix of the suffixes starting at lhs and rhs
+			int lce(int lhs, int rhs) const noexcept {
+				if (lhs == rhs)
+					return static_cast<int>(m_str.size()) - lhs;
+				int lo = 0, hi = static_cast<int>(m_str.size()) - std::max(lhs, rhs);
+				while (lo < hi) {
+					int mid = lo + (hi - lo + 1) / 2;
+					if ((*this)(lhs, mid) == (*this)(rhs, mid))
+						lo = mid;
+					else
+						hi = mid - 1;
+				}
+				return lo;
+			}
+
+			// Lexicographic order of the suffixes starting at lhs and rhs, after a single lce()
+			bool less(int lhs, int rhs) const noexcept {
+				int l = lce(lhs, rhs);
+				int len = static_cast<int>(m_str.size());
+				if (rhs + l == len)
+					return false; // rhs is a prefix of lhs (or they are equal)
+				if (lhs + l == len)
+					return true;
+				return static_cast<unsigned char>(m_str[lhs + l]) < static_cast<unsigned char>(m_str[rhs + l]);
+			}
+
+		private:
+			static constexpr std::uint64_t kModulus = (std::uint64_t(1) << 61) - 1;
+			static constexpr std::uint64_t kBase = 0x1d4b42f35c7a6e9ULL % kModulus;
+
+			static std::uint64_t reduce(std::uint64_t x) noexcept {
+				x = (x >> 61) + (x & kModulus);
+				return x >= kModulus ? x - kModulus : x;
+			}
+
+			// a * b mod 2^61 - 1 without 128 bit integers, so it builds with MSVC as well
+			static std::uint64_t multiply(std::uint64_t a, std::uint64_t b) noexcept {
+				std::uint64_t const mask30 = (std::uint64_t(1) << 30) - 1, mask31 = (std::uint64_t(1) << 31) - 1;
+				std::uint64_t const au = a >> 31, ad = a & mask31, bu = b >> 31, bd = b & mask31;
+				std::uint64_t const mid = ad * bu + au * bd;
+				return reduce(reduce(au * bu * 2 + (mid >> 30) + ((mid & mask30) << 31)) + reduce(ad * bd));
+			}
+
+			std::string const& m_str;
+			std::vector<std::uint64_t> m_prefix, m_power;
+		};
+
+		// Distinct, in range samples in suffix order
+		inline std::vector<int> sortedSamples(KarpRabin const& fingerprints, std::string const& str, std::vector<int> positions) {
+			std::sort(positions.begin(), positions.end());
+			positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+			positions.erase(std::remove_if(positions.begin(), positions.end(), [len = static_cast<int>(str.size())](int pos) noexcept {return pos < 0 || pos >= len; }), positions.end());
+			std::sort(positions.begin(), positions.end(), [&fingerprints](int lhs, int rhs) noexcept {return fingerprints.less(lhs, rhs); });
+			return positions;
+		}
+
+		template <class Predicate>
+		std::vector<int> sampledPositions(std::string const& str, Predicate const& pred) {
+			std::vector<int> positions;
+			for (int pos = 0; pos < static_cast<int>(str.size()); ++pos)
+				if (pred(str, pos))
+					positions.push_back(pos);
+			return positions;
+		}
+	} // namespace detail
+
+	// Sparse suffix array: same layout as suffixArray(), but only the suffixes starting at the sampled positions are indexed.
+	// Samples are sorted with fingerprint based comparisons, O(log n) each, so building takes O(n) for the fingerprints
+	// plus O(k log k log n) for k samples, independently of how repetitive the text is.
+	// The result takes O(k) space, but building it does not: the fingerprint table needs 16n bytes while it runs, more than
+	// a full suffix array of ints. The answer is wrong (with probability about k log k log n * n / 2^61) if two different
+	// substrings share a fingerprint.
+	inline std::vector<int> sparseSuffixArray(std::string const& str, std::vector<int> positions) {
+		return detail::sortedSamples(detail::KarpRabin(str), str, std::move(positions));
+	}
+
+	// Samples every position for which pred(str, pos) is true, e.g. the start of every word
+	template <class Predicate>
+	std::vector<int> sparseSuffixArray(std::string const& str, Predicate pred) {
+		return sparseSuffixArray(str, detail::sampledPositions(str, pred));
+	}
+
+	// True at the first character of every whitespace separated token
+	inline bool isWordStart(std::string const& str, int pos) noexcept {
+		auto isSpace = [](char c) noexcept {return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; };
+		return !isSpace(str[pos]) && (pos == 0 || isSpace(str[pos - 1]));
+	}
+
+	// Samples the first character of every whitespace separated token
+	inline std::vector<int> wordSuffixArray(std::string const& str) {
+		return sparseSuffixArray(str, isWordStart);
+	}
+
+	// LCP array over a sparse suffix array. Kasai's trick does not carry over (the suffix one step to the right of a sample
+	// is generally not sampled), so every adjacent pair gets a fingerprint based LCE query: O(n + k log n), with its own
+	// 16n byte fingerprint table. sparseSuffixLcpArray() builds both arrays from a single table.
+	inline std::vector<int> sparseLcpArray(std::string const& str, std::vector<int> const& ssa) {
+		detail::KarpRabin const fingerprints(str);
+		std::vector<int> lcp(ssa.size(), 0);
+		for (size_t i = 1; i < ssa.size(); ++i)
+			lcp[i] = fingerprints.lce(ssa[i - 1], ssa[i]);
+		return lcp;
+	}
+
+	// Sparse counterpart of suffixLcpArray(): (suffix, LCP with the previous one) pairs, sharing one fingerprint table
+	inline std::vector<std::pair<int, int>> sparseSuffixLcpArray(std::string const& str, std::vector<int> positions) {
+		detail::KarpRabin const fingerprints(str);
+		std::vector<int> const ssa = detail::sortedSamples(fingerprints, str, std::move(positions));
+		std::vector<std::pair<int, int>> ret(ssa.size());
+		for (size_t i = 0; i < ssa.size(); ++i)
+			ret[i] = std::make_pair(ssa[i], i == 0 ? 0 : fingerprints.lce(ssa[i - 1], ssa[i]));
+		return ret;
+	}
+
+	template <class Predicate>
+	std::vector<std::pair<int, int>> sparseSuffixLcpArray(std::string const& str, Predicate pred) {
+		return sparseSuffixLcpArray(str, detail::sampledPositions(str, pred));
+	}
+
+} // namespace jag::algo
+
+#endif // JAG_ALGO_SPARSE_SUFFIX_ARRAY_HPP
@@ -0,0 +1,97 @@
+#include "sparse_suffix_array.hpp"
+#include "suffix_array.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+using jag::algo::isWordStart;
+using jag::algo::sparseLcpArray;
+using jag::algo::sparseSuffixArray;
+using jag::algo::sparseSuffixLcpArray;
+using jag::algo::suffixArray;
+using jag::algo::suffixRange;
+using jag::algo::wordSuffixArray;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+TEST(Algorithms, sparseSuffixArray)
+{
+	EXPECT_THAT(sparseSuffixArray("banana", std::vector<int>{0, 2, 4}), ElementsAre(0, 4, 2));
+	EXPECT_THAT(sparseSuffixArray("banana", std::vector<int>{4, 0, 4, 9, -1}), ElementsAre(0, 4));
+	EXPECT_THAT(sparseSuffixArray("banana", [](std::string const& s, int pos) {return s[pos] == 'a'; }), ElementsAre(5, 3, 1));
+
+	// Sampling every position gives back the full suffix array
+	std::string const str = "ABRACADABRA$";
+	std::vector<int> all(str.size());
+	std::iota(all.begin(), all.end(), 0);
+	EXPECT_EQ(suffixArray(str), sparseSuffixArray(str, all));
+
+	// Bytes above 0x7f (UTF-8 text) sort after ASCII in both, as std::string compares them
+	std::string const utf8 = "a\xc3\xa9 b a\xc3\xa9";
+	std::vector<int> allUtf8(utf8.size());
+	std::iota(allUtf8.begin(), allUtf8.end(), 0);
+	EXPECT_EQ(suffixArray(utf8), sparseSuffixArray(utf8, allUtf8));
+	EXPECT_THAT(suffixArray(utf8), ElementsAre(5, 3, 6, 0, 4, 8, 2, 7, 1));
+}
+
+TEST(Algorithms, wordSuffixArray)
+{
+	EXPECT_THAT(wordSuffixArray("to be or not to be"), ElementsAre(16, 3, 9, 6, 13, 0));
+	EXPECT_THAT(wordSuffixArray("  a\tb\n"), ElementsAre(2, 4));
+	EXPECT_TRUE(wordSuffixArray("   ").empty());
+}
+
+TEST(Algorithms, sparseLcpArray)
+{
+	std::string const str = "to be or not to be";
+	EXPECT_THAT(sparseLcpArray(str, wordSuffixArray(str)), ElementsAre(0, 2, 0, 0, 0, 5));
+	EXPECT_THAT(sparseLcpArray("aaaaaa", sparseSuffixArray("aaaaaa", std::vector<int>{0, 2, 4})), ElementsAre(0, 2, 4));
+}
+
+TEST(Algorithms, sparseSuffixLcpArray)
+{
+	std::string const str = "to be or not to be";
+	EXPECT_THAT(sparseSuffixLcpArray(str, isWordStart), ElementsAre(Pair(16, 0), Pair(3, 2), Pair(9, 0), Pair(6, 0), Pair(13, 0), Pair(0, 5)));
+	EXPECT_THAT(sparseSuffixLcpArray("aaaaaa", std::vector<int>{4, 0, 2}), ElementsAre(Pair(4, 0), Pair(2, 2), Pair(0, 4)));
+	EXPECT_TRUE(sparseSuffixLcpArray("", std::vector<int>{0}).empty());
+}
+
+TEST(Algorithms, suffixRange)
+{
+	std::string const str = "to be or not to be";
+	std::vector<int> const words = wordSuffixArray(str);
+	EXPECT_THAT(suffixRange(str, words, "be"), Pair(0, 2));
+	EXPECT_THAT(suffixRange(str, words, "to"), Pair(4, 6));
+	EXPECT_THAT(suffixRange(str, words, "o"), Pair(3, 4)); // "or" starts a word, the "o" of "to" does not count
+	EXPECT_THAT(suffixRange(str, words, "x"), Pair(6, 6));
+
+	EXPECT_THAT(suffixRange("banana", suffixArray("banana"), "ana"), Pair(1, 3));
+
+	std::string const utf8 = "a\xc3\xa9 b a";
+	EXPECT_THAT(suffixRange(utf8, suffixArray(utf8), "\xc3\xa9"), Pair(6, 7));
+	EXPECT_THAT(suffixRange(utf8, wordSuffixArray(utf8), "a\xc3\xa9"), Pair(1, 2));
+}
+
+TEST(Algorithms, sparseSuffixArrayRepetitive)
+{
+	// A repeated log line: the fingerprints must order and measure suffixes sharing thousands of characters
+	std::string str;
+	for (int i = 0; i < 200; ++i)
+		str += "2024-01-01 INFO worker started job id=42 status=ok\n";
+	str += "2024-01-01 INFO worker started job id=42 status=failed\n";
+
+	std::vector<int> expected;
+	for (int pos = 0; pos < static_cast<int>(str.size()); pos += 3)
+		expected.push_back(pos);
+	std::string_view const text(str);
+	std::sort(expected.begin(), expected.end(), [text](int lhs, int rhs) {return text.substr(lhs) < text.substr(rhs); });
+
+	std::vector<int> const ssa = sparseSuffixArray(str, [](std::string const&, int pos) {return pos % 3 == 0; });
+	ASSERT_EQ(expected, ssa);
+
+	std::vector<int> const lcp = sparseLcpArray(str, ssa);
+	for (size_t i = 1; i < ssa.size(); ++i) {
+		std::string_view const prev = text.substr(ssa[i - 1]), curr = text.substr(ssa[i]);
+		EXPECT_EQ(std::mismatch(curr.begin(), curr.end(), prev.begin(), prev.end()).first - curr.begin(), lcp[i]) << i;
+	}
+}
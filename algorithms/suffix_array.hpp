@@ -4,7 +4,9 @@
 #include <algorithm>
 #include <numeric>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace jag::algo {
@@ -23,53 +25,70 @@ namespace jag::algo {
 	}
 
 
-	// Prefix-doubling algo to build a suffixArray
+	// Prefix-doubling algo to build a suffixArray, O(n log n).
+	// Every round orders the suffixes by their first 2k characters, as the pair (rank of the first k, rank of the next k).
+	// Pairs are radix sorted: the second key is already in suffix array order from the previous round, so a single stable
+	// counting pass over the first key finishes the job. It stops as soon as all the ranks are distinct.
 	inline std::vector<int> suffixArray(std::string const& str) {
 		int len = static_cast<int>(str.size());
+		std::vector<int> suffixes(len), rank(len), next(len);
+		if (len == 0)
+			return suffixes;
 
-		// I will create a vector of tuples, describing the ranks, the next ranks and the suffixes (meaning rank of the next suffix + k)
-		std::vector<std::tuple<int, int, int>> ranks(str.size());
-		// initial ranks are the ASCII values of the chars, and for id I pick 0 to n-1. the next-rank is -1 for now
-		std::transform(str.cbegin(), str.cend(), ranks.begin(),[i = 0](auto c) mutable noexcept {return std::make_tuple(c, -1, i++);});
+		// Initial ranks are the (unsigned, like std::string comparisons) values of the chars
+		std::vector<int> count(std::max(len, 256) + 1, 0);
+		for (int i = 0; i < len; ++i)
+			rank[i] = static_cast<unsigned char>(str[i]);
+		for (int i = 0; i < len; ++i)
+			++count[rank[i] + 1];
+		for (size_t r = 1; r < count.size(); ++r)
+			count[r] += count[r - 1];
+		for (int i = 0; i < len; ++i)
+			suffixes[count[rank[i]]++] = i;
 
-		// Adjust next-rank to rank of the next element. We won't touch the last one obviously
-		// In this case, it means the ascii value of the next char
-		std::transform(ranks.begin(), prev(ranks.end()), next(ranks.cbegin()), ranks.begin(),[](auto& current, auto const& next) noexcept {std::get<1>(current) = std::get<0>(next); return current;});
+		for (int skip = 1;; skip *= 2) {
+			// Order by the second key: suffixes with nothing left after skip characters first, then the rest as sorted so far
+			int filled = 0;
+			for (int i = len - skip; i < len; ++i)
+				if (i >= 0)
+					next[filled++] = i;
+			for (int i = 0; i < len; ++i)
+				if (suffixes[i] >= skip)
+					next[filled++] = suffixes[i] - skip;
 
-		// Since tuple is rank-followingTank-index, this sorts according to rank value
-		sort(ranks.begin(), ranks.end());
-		
-		for (int skip = 1; skip < len; skip *= 2)
-		{
-			std::adjacent_difference(ranks.cbegin(), ranks.cend(), ranks.begin(),
-				[rank = 0](auto curr, auto const& prev) mutable noexcept {
-					rank += ((std::get<0>(prev) == std::get<0>(curr)) && (std::get<1>(prev) == std::get<1>(curr))) ? 0 : 1;
-					std::get<0>(curr) = rank;
-					std::get<1>(curr) = -1;
-					return curr;
-				});
-			std::get<0>(ranks[0]) = 0;
+			// Stable counting sort on the first key
+			int const ranks = std::max(rank[suffixes[len - 1]] + 1, 256);
+			std::fill(count.begin(), count.begin() + ranks + 1, 0);
+			for (int i = 0; i < len; ++i)
+				++count[rank[i] + 1];
+			for (int r = 1; r <= ranks; ++r)
+				count[r] += count[r - 1];
+			for (int i = 0; i < len; ++i)
+				suffixes[count[rank[next[i]]]++] = next[i];
 
-
-			// I will sort according to the index, so I can use the index to find the next element
-			// This is faster than doing find_if for every index to find where is the index+skip value
-			sort(ranks.begin(), ranks.end(), [](auto const& lhs, auto const& rhs) noexcept {return std::get<2>(lhs) < std::get<2>(rhs); });
-
-			// I will now adjust the values of rank[sa[i]+k] for all i's within range
-			std::transform(std::next(ranks.cbegin(), skip), ranks.cend(), ranks.cbegin(), ranks.begin(),
-				[](auto const& skipRank, auto  currentRank) noexcept {std::get<1>(currentRank) = std::get<0>(skipRank); return currentRank; });
-
-			// And I sort again, according to ranks...
-			sort(ranks.begin(), ranks.end());
-			// Optimization: If the last element has rank == len - 1, we can stop
-			if (std::get<0>(ranks[0]) == len - 1)
+			// New ranks, equal for equal pairs
+			auto secondKey = [&](int i) noexcept { return i + skip < len ? rank[i + skip] : -1; };
+			next[suffixes[0]] = 0;
+			for (int i = 1; i < len; ++i) {
+				int const prev = suffixes[i - 1], curr = suffixes[i];
+				next[curr] = next[prev] + ((rank[prev] != rank[curr] || secondKey(prev) != secondKey(curr)) ? 1 : 0);
+			}
+			rank.swap(next);
+			// Once every rank is distinct (the last one is len - 1), the order cannot change anymore
+			if (rank[suffixes[len - 1]] == len - 1 || skip >= len)
 				break;
 		}
-
-		std::vector<int> suffixes(len);
-		transform(ranks.cbegin(), ranks.cend(), suffixes.begin(), [](auto const& tup) noexcept {return std::get<2>(tup); });
 		return suffixes;
 	}
+
+	// Range [first, last) of sa whose suffixes start with pattern. Works on full and sparse suffix arrays alike.
+	inline std::pair<int, int> suffixRange(std::string const& str, std::vector<int> const& sa, std::string const& pattern) {
+		std::string_view const text(str);
+		size_t const len = pattern.size();
+		auto first = std::lower_bound(sa.cbegin(), sa.cend(), pattern, [text, len](int suffix, std::string const& p) noexcept {return text.substr(suffix, len) < p; });
+		auto last = std::upper_bound(first, sa.cend(), pattern, [text, len](std::string const& p, int suffix) noexcept {return p < text.substr(suffix, len); });
+		return std::make_pair(static_cast<int>(first - sa.cbegin()), static_cast<int>(last - sa.cbegin()));
+	}
 } // namespace jag::algo
 
 #endif // JAG_ALGO_STRING_ARRAY_HPP
@@ -1,6 +1,8 @@
 #ifndef JAG_ALGO_SUFFIX_AUTOMATON_HPP
 #define JAG_ALGO_SUFFIX_AUTOMATON_HPP
 
+#include <algorithm>
+#include <cassert>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -14,16 +16,18 @@ namespace jag::algo {
             char m_character;
             std::unordered_map<char, int> m_edges;
             int m_length, m_link;
+            int m_firstPos; // end position of the first occurrence in the text
             int m_size;
             bool m_final;
         };
 
-        SuffixAutomaton() : m_last(0)
+        SuffixAutomaton() : m_last(0), m_split(-1)
         {
             m_states.emplace_back();
             State& state = m_states.back();
             state.m_link = -1;
             state.m_length = 0;
+            state.m_firstPos = -1;
             state.m_size = 1;
             state.m_final = false;
             state.m_character = '$';
@@ -83,6 +87,7 @@ namespace jag::algo {
         int maxLen() const noexcept { return std::max_element(m_states.begin(), m_states.end(), [](State const& lhs, State const& rhs) {return lhs.m_length < rhs.m_length; })->m_length; }
 
         SuffixAutomaton& append(char c) {
+            m_split = -1;
             // We add new state corresponding to s + c
             // It will has index curr.
             m_states.emplace_back();
@@ -90,6 +95,7 @@ namespace jag::algo {
             {
                 State& state = m_states.back();
                 state.m_length = m_states[m_last].m_length + 1;
+                state.m_firstPos = state.m_length - 1;
                 state.m_link = -2;
                 state.m_size = 1;
                 state.m_final = false;
@@ -114,6 +120,7 @@ namespace jag::algo {
                     m_states[clone].m_size = 0;
                     m_states[curr].m_link = clone;
                     m_states[q].m_link = clone;
+                    m_split = q;
                     for (; p != -1; p = m_states[p].m_link) {
                         auto it = m_states[p].m_edges.find(c);
                         if (it != end(m_states[p].m_edges) && it->second == q)
@@ -131,6 +138,7 @@ namespace jag::algo {
 
         std::vector<State> m_states;
         int m_last;
+        int m_split; // state the last append() split in two, its clone being the last state; -1 if none
 	};
 } // namespace jag::algo
 #endif //JAG_ALGO_SUFFIX_AUTOMATON_HPP
@@ -39,7 +39,7 @@ namespace jag::algo {
 			void setLength(int len) noexcept { m_end = m_start + len; m_str = m_str.substr(0, len); }
 
 			int edgeLength() const noexcept { return static_cast<int>(m_str.size()); }
-			int edgeLength(int pos) const noexcept { return std::max(m_end, pos + 1) - m_start; }
+			int edgeLength(int pos) const noexcept { return (m_end == -1 ? pos + 1 : m_end) - m_start; }
 
 			void clear() noexcept { m_edges.clear(); m_start = 0; m_end = 0;}
 
@@ -129,49 +129,48 @@ namespace jag::algo {
 						// We also create a suffix link from the old internal node to the new one.
 						// The new internal node will have an edge for the new character,
 
-						/* THIS IS THE OLD CODE, WHERE THE SPLIT NODE IS A NEW ONE 
-						
-						int splitId = createNode(m_nodes[nextId].m_start, m_nodes[nextId].m_start + m_activeLength);
-						int leafId = createNode(pos);
-						Node& activeNode = m_nodes[m_activeNode];
-						Node& split = m_nodes[splitId];
-						Node& leaf = m_nodes.back();
-
-						
-						// New leaf coming out of the new internal node
-						m_nodes[nextId].m_start += m_activeLength;
-						auto nextIdStartChar = m_data[m_nodes[nextId].m_start];
-
-						activeNode.at(activeEdgeLetter) = splitId; // Now activenode has an edge pointing here
-						split.at(c) = leafId;
-						split.at(nextIdStartChar) = nextId;
-
-						// We got a new internal node. If there is any internal node created in last extensions
-						// of same phase which is still waiting for it's suffix link reset, do it now.
-						addSuffixLink(splitId); //rule 2
-						*/
-
-						// New code, I reuse the old node for the split node (I like the topology of the tree better)
-
-						m_nodes.push_back(m_nodes[nextId]); // Copy the node, I want to reuse the bucket for the split node
-						int leafId = createNode(pos);
-						int splitId = leafId - 1;
-
-						Node& internalNode = m_nodes[nextId];
-						Node& split = m_nodes[splitId];
-						Node& leaf = m_nodes.back();
-
-						internalNode.setLength(m_activeLength);
-						split.m_start += m_activeLength;
-						//split.adjust(m_data);
-
-						char activeLetter = m_data[split.m_start];
-						// The internal node now will point to the 'old' activeEdge and the new character c
-						internalNode.at(c) = leafId;
-						internalNode.at(activeLetter) = splitId;
-						// We got a new internal node. If there is any internal node created in last extensions
-						// of same phase which is still waiting for it's suffix link reset, do it now.
-						addSuffixLink(splitId); // rule 2
+						if (!m_nodes[nextId].isLeaf()) {
+							// Splitting an internal node: other nodes may hold suffix links to nextId, so it must keep its index.
+							// The split node is a new one, inserted between the active node and nextId.
+							int splitId = createNode(m_nodes[nextId].m_start, m_nodes[nextId].m_start + m_activeLength);
+							int leafId = createNode(pos);
+
+							// New leaf coming out of the new internal node
+							m_nodes[nextId].m_start += m_activeLength;
+							m_nodes[nextId].adjust(m_data);
+							char nextIdStartChar = m_data[m_nodes[nextId].m_start];
+
+							m_nodes[m_activeNode].at(activeEdgeLetter) = splitId; // Now activenode has an edge pointing here
+							m_nodes[splitId].at(c) = leafId;
+							m_nodes[splitId].at(nextIdStartChar) = nextId;
+
+							// We got a new internal node. If there is any internal node created in last extensions
+							// of same phase which is still waiting for it's suffix link reset, do it now.
+							addSuffixLink(splitId); //rule 2
+						}
+						else {
+							// Splitting a leaf: nothing links to a leaf, so I reuse its bucket for the new internal node
+							// and move the leaf to the end (I like the topology of the tree better)
+							m_nodes.push_back(m_nodes[nextId]); // Copy the node, I want to reuse the bucket for the split node
+							int leafId = createNode(pos);
+							int splitId = leafId - 1;
+
+							Node& internalNode = m_nodes[nextId];
+							Node& split = m_nodes[splitId];
+
+							internalNode.setLength(m_activeLength);
+							internalNode.m_link = 0;
+							split.m_start += m_activeLength;
+							split.adjust(m_data);
+
+							char activeLetter = m_data[split.m_start];
+							// The internal node now will point to the 'old' activeEdge and the new character c
+							internalNode.at(c) = leafId;
+							internalNode.at(activeLetter) = splitId;
+							// We got a new internal node. If there is any internal node created in last extensions
+							// of same phase which is still waiting for it's suffix link reset, do it now.
+							addSuffixLink(nextId); // rule 2
+						}
 
 
 					}
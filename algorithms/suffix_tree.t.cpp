@@ -29,13 +29,15 @@ TEST(SuffixTree, Constructor) {
 		SuffixTree st("aaa");
 		EXPECT_EQ(st.size(), 7);
 		EXPECT_EQ(2, st[0].size()); // root should have 2 edges
-		EXPECT_EQ(1, st[0].at('a'));
+		EXPECT_EQ(4, st[0].at('a'));
 		EXPECT_EQ(6, st[0].at('$'));
 
-		EXPECT_EQ("a", st[1].str());
-		EXPECT_FALSE(st[1].isLeaf());
-		EXPECT_EQ(0, st[1].m_start);
-		EXPECT_EQ(1, st[1].m_end);
+		EXPECT_EQ("a", st[4].str());
+		EXPECT_FALSE(st[4].isLeaf());
+		EXPECT_EQ(0, st[4].m_start);
+		EXPECT_EQ(1, st[4].m_end);
+		EXPECT_EQ(1, st[4].at('a'));
+		EXPECT_EQ(5, st[4].at('$'));
 
 		EXPECT_EQ("a$", st[2].str());
 		EXPECT_TRUE(st[2].isLeaf());
@@ -48,13 +50,13 @@ TEST(SuffixTree, Constructor) {
 		EXPECT_EQ(3, st[3].m_start);
 		EXPECT_EQ(-1, st[3].m_end);
 
-		EXPECT_EQ("a", st[4].str());
-		EXPECT_FALSE(st[4].isLeaf());
-		EXPECT_EQ(1, st[4].m_start);
-		EXPECT_EQ(2, st[4].m_end);
-		EXPECT_EQ(2, st[4].size());
-		EXPECT_EQ(2, st[4].at('a'));
-		EXPECT_EQ(3, st[4].at('$'));
+		EXPECT_EQ("a", st[1].str());
+		EXPECT_FALSE(st[1].isLeaf());
+		EXPECT_EQ(1, st[1].m_start);
+		EXPECT_EQ(2, st[1].m_end);
+		EXPECT_EQ(2, st[1].size());
+		EXPECT_EQ(2, st[1].at('a'));
+		EXPECT_EQ(3, st[1].at('$'));
 
 		EXPECT_EQ("$", st[5].str());
 		EXPECT_TRUE(st[5].isLeaf());
@@ -108,3 +110,14 @@ TEST(SuffixTree, contains) {
 	EXPECT_TRUE(st.contains("xabt"));
 	EXPECT_FALSE(st.contains("xabd"));
 }
+
+TEST(SuffixTree, containsAllSubstrings) {
+	for (std::string const str : { "mississippi", "abcabxabcd", "dedododeeodo", "bbcbbba" }) {
+		SuffixTree st(str);
+		for (size_t i = 0; i < str.size(); ++i)
+			for (size_t len = 1; i + len <= str.size(); ++len) {
+				EXPECT_TRUE(st.contains(str.substr(i, len))) << str << " " << str.substr(i, len);
+				EXPECT_FALSE(st.contains(str.substr(i, len) + "#")) << str << " " << str.substr(i, len);
+			}
+	}
+}
@@ -0,0 +1,278 @@
+#ifndef JAG_ALGO_SUFFIX_TREE_REPEATS_HPP
+#define JAG_ALGO_SUFFIX_TREE_REPEATS_HPP
+
+#include "suffix_tree.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace jag::algo {
+
+	namespace detail {
+		// Calls fn(i) for i in [0, count), spread over threads (0 means one per hardware thread)
+		template <class Fn>
+		void parallelFor(int count, unsigned threads, Fn const& fn) {
+			if (threads == 0)
+				threads = std::max(1u, std::thread::hardware_concurrency());
+			threads = std::min<unsigned>(threads, std::max(count, 1));
+
+			std::atomic<int> next{ 0 };
+			auto worker = [&]() {
+				for (int i = next++; i < count; i = next++)
+					fn(i);
+			};
+			std::vector<std::thread> pool;
+			for (unsigned t = 1; t < threads; ++t)
+				pool.emplace_back(worker);
+			worker();
+			for (auto& thread : pool)
+				thread.join();
+		}
+	} // namespace detail
+
+	// Iterative post-order fold over the subtree rooted at node, whose path label is depth characters long.
+	// The visitor provides:
+	//   Summary leaf(int node, int suffix)                     a leaf and the start of its suffix
+	//   void merge(Summary& parent, Summary const& child)      folds a child into its parent
+	//   void internal(int node, int depth, Summary& summary)   called once all the children of an internal node are merged
+	// An explicit stack is used so that deep trees (long repeats) cannot overflow the call stack.
+	template <class Visitor>
+	typename Visitor::Summary foldSubtree(SuffixTree const& st, int node, int depth, Visitor const& visitor) {
+		using Summary = typename Visitor::Summary;
+		int const textLength = static_cast<int>(st.m_data.size());
+		if (st[node].isLeaf())
+			return visitor.leaf(node, textLength - depth);
+
+		struct Frame {
+			int m_node, m_depth;
+			SuffixTree::Node::const_iterator m_next;
+			Summary m_summary;
+		};
+		std::vector<Frame> stack;
+		stack.push_back(Frame{ node, depth, st[node].begin(), Summary{} });
+		while (true) {
+			Frame& top = stack.back();
+			if (top.m_next == st[top.m_node].end()) {
+				visitor.internal(top.m_node, top.m_depth, top.m_summary);
+				Summary summary = std::move(top.m_summary);
+				stack.pop_back();
+				if (stack.empty())
+					return summary;
+				visitor.merge(stack.back().m_summary, summary);
+				continue;
+			}
+			int child = (top.m_next++)->second;
+			int childDepth = top.m_depth + st[child].edgeLength();
+			if (st[child].isLeaf())
+				visitor.merge(top.m_summary, visitor.leaf(child, textLength - childDepth));
+			else
+				stack.push_back(Frame{ child, childDepth, st[child].begin(), Summary{} });
+		}
+	}
+
+	// Same fold over the whole tree, with the subtrees of the root's children processed on separate threads.
+	// The visitor is shared between threads, so leaf/merge/internal must be safe to call concurrently.
+	template <class Visitor>
+	typename Visitor::Summary foldTree(SuffixTree const& st, Visitor const& visitor, unsigned threads = 0) {
+		using Summary = typename Visitor::Summary;
+		std::vector<int> children;
+		for (auto const& edge : st[0])
+			children.push_back(edge.second);
+
+		std::vector<Summary> summaries(children.size());
+		detail::parallelFor(static_cast<int>(children.size()), threads, [&](int i) {
+			summaries[i] = foldSubtree(st, children[i], st[children[i]].edgeLength(), visitor);
+		});
+
+		Summary root{};
+		for (auto const& summary : summaries)
+			visitor.merge(root, summary);
+		visitor.internal(0, 0, root);
+		return root;
+	}
+
+	// A repeated substring, reported as one of its occurrences
+	struct Repeat {
+		int m_start, m_length;
+		int m_count; // number of occurrences
+	};
+
+	// A tandem repeat ww starting at m_start, where w is m_period characters long
+	struct TandemRepeat {
+		int m_start, m_period;
+	};
+
+	namespace detail {
+		// Left character of the suffix starting at pos; the suffix at 0 has none, which makes it differ from every other one
+		inline int leftCharacter(SuffixTree const& st, int pos) noexcept {
+			return pos == 0 ? -1 : static_cast<unsigned char>(st.m_data[pos - 1]);
+		}
+
+		template <class Callback>
+		struct MaximalRepeatVisitor {
+			static constexpr int kNone = -2, kMixed = -3;
+			struct Summary {
+				int m_leaves = 0;
+				int m_suffix = -1;
+				int m_left = kNone;
+			};
+
+			SuffixTree const& m_tree;
+			int m_minLength, m_minCount;
+			Callback const& m_callback;
+
+			Summary leaf(int, int suffix) const noexcept {
+				int left = leftCharacter(m_tree, suffix);
+				return Summary{ 1, suffix, left == -1 ? kMixed : left };
+			}
+			void merge(Summary& parent, Summary const& child) const noexcept {
+				parent.m_leaves += child.m_leaves;
+				if (parent.m_suffix == -1)
+					parent.m_suffix = child.m_suffix;
+				if (parent.m_left == kNone)
+					parent.m_left = child.m_left;
+				else if (parent.m_left != child.m_left)
+					parent.m_left = kMixed;
+			}
+			// Internal nodes are right-maximal, they are maximal if their occurrences are not all preceded by the same character
+			void internal(int, int depth, Summary const& summary) const {
+				if (depth > 0 && depth >= m_minLength && summary.m_leaves >= m_minCount && summary.m_left == kMixed)
+					m_callback(Repeat{ summary.m_suffix, depth, summary.m_leaves });
+			}
+		};
+
+		template <class Callback>
+		struct SupermaximalRepeatVisitor {
+			struct Summary {
+				bool m_isLeaf = false;
+				bool m_candidate = true; // all children are leaves with pairwise distinct left characters
+				int m_leaves = 0;
+				int m_suffix = -1;
+				std::bitset<256> m_lefts;
+			};
+
+			SuffixTree const& m_tree;
+			int m_minLength, m_minCount;
+			Callback const& m_callback;
+
+			Summary leaf(int, int suffix) const noexcept {
+				Summary summary;
+				summary.m_isLeaf = true;
+				summary.m_leaves = 1;
+				summary.m_suffix = suffix;
+				return summary;
+			}
+			void merge(Summary& parent, Summary const& child) const noexcept {
+				parent.m_leaves += child.m_leaves;
+				if (parent.m_suffix == -1)
+					parent.m_suffix = child.m_suffix;
+				if (!parent.m_candidate)
+					return;
+				if (!child.m_isLeaf) {
+					parent.m_candidate = false;
+					return;
+				}
+				int left = leftCharacter(m_tree, child.m_suffix);
+				if (left == -1)
+					return;
+				if (parent.m_lefts.test(left))
+					parent.m_candidate = false;
+				parent.m_lefts.set(left);
+			}
+			void internal(int, int depth, Summary& summary) const {
+				if (depth > 0 && depth >= m_minLength && summary.m_leaves >= m_minCount && summary.m_candidate)
+					m_callback(Repeat{ summary.m_suffix, depth, summary.m_leaves });
+				summary.m_lefts.reset();
+			}
+		};
+	} // namespace detail
+
+	// Maximal repeats: substrings occurring at least twice that cannot be extended to the left or to the right
+	// without losing an occurrence. callback(Repeat) may be called concurrently from several threads.
+	template <class Callback>
+	void maximalRepeats(SuffixTree const& st, Callback const& callback, int minLength = 1, int minCount = 2, unsigned threads = 0) {
+		foldTree(st, detail::MaximalRepeatVisitor<Callback>{ st, minLength, std::max(minCount, 2), callback }, threads);
+	}
+
+	// Supermaximal repeats: maximal repeats that do not occur inside any other maximal repeat.
+	// callback(Repeat) may be called concurrently from several threads.
+	template <class Callback>
+	void supermaximalRepeats(SuffixTree const& st, Callback const& callback, int minLength = 1, int minCount = 2, unsigned threads = 0) {
+		foldTree(st, detail::SupermaximalRepeatVisitor<Callback>{ st, minLength, std::max(minCount, 2), callback }, threads);
+	}
+
+	// Every occurrence of a tandem repeat ww with |w| >= minPeriod, in O(n log n + output) (Stoye & Gusfield).
+	// A tandem repeat is branching when the characters following its two halves differ. Those are found at the node whose path
+	// label is w, checking only the leaves outside its largest child; every other occurrence is a left rotation of a branching one.
+	// Internal nodes are spread over threads, so callback(TandemRepeat) may be called concurrently.
+	template <class Callback>
+	void tandemRepeats(SuffixTree const& st, Callback const& callback, int minPeriod = 1, unsigned threads = 0) {
+		int const nodeCount = static_cast<int>(st.size());
+		int const textLength = static_cast<int>(st.m_data.size());
+		std::string const& text = st.m_data;
+
+		// Leaves numbered in depth first order: every node owns the range [first, last) of leaf numbers
+		std::vector<int> depth(nodeCount, 0), first(nodeCount, 0), last(nodeCount, 0);
+		std::vector<int> leafAt, rank(textLength, 0);
+		leafAt.reserve(textLength);
+		std::vector<std::pair<int, SuffixTree::Node::const_iterator>> stack{ { 0, st[0].begin() } };
+		while (!stack.empty()) {
+			auto& [node, next] = stack.back();
+			if (next == st[node].end()) {
+				last[node] = static_cast<int>(leafAt.size());
+				stack.pop_back();
+				continue;
+			}
+			int child = (next++)->second;
+			depth[child] = depth[node] + st[child].edgeLength();
+			first[child] = static_cast<int>(leafAt.size());
+			if (st[child].isLeaf()) {
+				rank[textLength - depth[child]] = static_cast<int>(leafAt.size());
+				leafAt.push_back(textLength - depth[child]);
+				last[child] = static_cast<int>(leafAt.size());
+			}
+			else
+				stack.emplace_back(child, st[child].begin());
+		}
+
+		auto report = [&](int start, int period) {
+			callback(TandemRepeat{ start, period });
+			// Rotating a tandem repeat to the left keeps it a tandem repeat as long as the characters entering and leaving match
+			for (; start > 0 && text[start - 1] == text[start + period - 1]; --start)
+				callback(TandemRepeat{ start - 1, period });
+		};
+
+		detail::parallelFor(nodeCount, threads, [&](int node) {
+			int const period = depth[node];
+			if (node == 0 || st[node].isLeaf() || period < minPeriod)
+				return;
+			int big = -1;
+			for (auto const& edge : st[node])
+				if (big == -1 || last[edge.second] - first[edge.second] > last[big] - first[big])
+					big = edge.second;
+			auto inside = [&](int pos, int child) { return pos >= 0 && pos < textLength && rank[pos] >= first[child] && rank[pos] < last[child]; };
+
+			for (auto const& edge : st[node]) {
+				if (edge.second == big)
+					continue;
+				for (int k = first[edge.second]; k < last[edge.second]; ++k) {
+					int pos = leafAt[k];
+					// pos is the first half, the second half starts under another child of this node
+					if (inside(pos + period, node) && text[pos + period] != text[pos + 2 * period])
+						report(pos, period);
+					// pos is the second half and the first half starts under the largest child
+					if (inside(pos - period, big))
+						report(pos - period, period);
+				}
+			}
+		});
+	}
+
+} // end of namespace jag::algo
+
+#endif // JAG_ALGO_SUFFIX_TREE_REPEATS_HPP
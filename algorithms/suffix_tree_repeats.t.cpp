@@ -0,0 +1,131 @@
+#include "suffix_tree_repeats.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+
+using jag::algo::maximalRepeats;
+using jag::algo::Repeat;
+using jag::algo::SuffixTree;
+using jag::algo::supermaximalRepeats;
+using jag::algo::TandemRepeat;
+using jag::algo::tandemRepeats;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+namespace {
+	std::vector<int> occurrences(std::string const& str, std::string const& sub) {
+		std::vector<int> ret;
+		for (size_t pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + 1))
+			ret.push_back(static_cast<int>(pos));
+		return ret;
+	}
+
+	std::map<std::string, int> bruteForceMaximalRepeats(std::string const& str) {
+		std::map<std::string, int> ret;
+		for (size_t i = 0; i < str.size(); ++i)
+			for (size_t len = 1; i + len <= str.size(); ++len) {
+				std::string const sub = str.substr(i, len);
+				auto const occ = occurrences(str, sub);
+				if (occ.size() < 2)
+					continue;
+				// An occurrence at the start (end) of the text cannot be extended to the left (right)
+				std::set<int> lefts, rights;
+				for (int pos : occ) {
+					lefts.insert(pos == 0 ? -1 - pos : str[pos - 1]);
+					rights.insert(pos + len == str.size() ? -1 : str[pos + len]);
+				}
+				if (lefts.size() > 1 && rights.size() > 1)
+					ret[sub] = static_cast<int>(occ.size());
+			}
+		return ret;
+	}
+
+	std::map<std::string, int> collect(std::string const& str, std::vector<Repeat> const& repeats) {
+		std::map<std::string, int> ret;
+		for (auto const& repeat : repeats)
+			ret[str.substr(repeat.m_start, repeat.m_length)] = repeat.m_count;
+		return ret;
+	}
+
+	template <class Fn>
+	std::vector<Repeat> run(Fn fn, std::string const& str, unsigned threads) {
+		SuffixTree st(str);
+		std::mutex mutex;
+		std::vector<Repeat> repeats;
+		fn(st, [&](Repeat const& repeat) { std::lock_guard lock(mutex); repeats.push_back(repeat); }, threads);
+		return repeats;
+	}
+
+	std::vector<std::string> const inputs = { "banana", "mississippi", "abcabxabcd", "aaaaaaa", "abababab", "GATAGACA", "xabxac",
+		"aacbbabbabbbbbaaaaaaabbbbcacacbcabaccaabbbcaaabbccccbbbcbccccbbcaabaaabcbaacbcbaccaaaccbccbcaacbaccbaacbbabbabbbbb" };
+}
+
+TEST(SuffixTreeRepeats, maximalRepeats)
+{
+	SuffixTree st("abcabxabcd");
+	std::vector<Repeat> repeats;
+	maximalRepeats(st, [&](Repeat const& repeat) { repeats.push_back(repeat); }, 1, 2, 1);
+	EXPECT_THAT(collect("abcabxabcd", repeats), ElementsAre(Pair("ab", 3), Pair("abc", 2)));
+
+	for (auto const& str : inputs)
+		for (unsigned threads : { 1u, 4u }) {
+			auto const repeats = run([](auto const& st, auto const& cb, unsigned t) { maximalRepeats(st, cb, 1, 2, t); }, str, threads);
+			EXPECT_EQ(bruteForceMaximalRepeats(str), collect(str, repeats)) << str;
+			EXPECT_EQ(bruteForceMaximalRepeats(str).size(), repeats.size()) << str;
+		}
+}
+
+TEST(SuffixTreeRepeats, filters)
+{
+	std::string const str = "abcabxabcd";
+	auto const longOnes = run([](auto const& st, auto const& cb, unsigned t) { maximalRepeats(st, cb, 3, 2, t); }, str, 2);
+	EXPECT_THAT(collect(str, longOnes), ElementsAre(Pair("abc", 2)));
+	auto const frequent = run([](auto const& st, auto const& cb, unsigned t) { maximalRepeats(st, cb, 1, 3, t); }, str, 2);
+	EXPECT_THAT(collect(str, frequent), ElementsAre(Pair("ab", 3)));
+}
+
+TEST(SuffixTreeRepeats, supermaximalRepeats)
+{
+	for (auto const& str : inputs) {
+		auto const maximal = bruteForceMaximalRepeats(str);
+		std::map<std::string, int> expected;
+		for (auto const& [sub, count] : maximal)
+			if (std::none_of(maximal.begin(), maximal.end(), [&sub](auto const& other) { return other.first != sub && other.first.find(sub) != std::string::npos; }))
+				expected[sub] = count;
+
+		auto const repeats = run([](auto const& st, auto const& cb, unsigned t) { supermaximalRepeats(st, cb, 1, 2, t); }, str, 4);
+		EXPECT_EQ(expected, collect(str, repeats)) << str;
+	}
+}
+
+TEST(SuffixTreeRepeats, tandemRepeats)
+{
+	for (auto const& str : inputs)
+		for (int minPeriod : { 1, 2 }) {
+			std::set<std::pair<int, int>> expected;
+			for (int pos = 0; pos < static_cast<int>(str.size()); ++pos)
+				for (int period = minPeriod; pos + 2 * period <= static_cast<int>(str.size()); ++period)
+					if (str.compare(pos, period, str, pos + period, period) == 0)
+						expected.emplace(pos, period);
+
+			SuffixTree st(str);
+			std::mutex mutex;
+			std::multiset<std::pair<int, int>> found, all(expected.begin(), expected.end());
+			tandemRepeats(st, [&](TandemRepeat const& tandem) { std::lock_guard lock(mutex); found.emplace(tandem.m_start, tandem.m_period); }, minPeriod, 4);
+			EXPECT_EQ(all, found) << str; // every occurrence exactly once
+		}
+}
+
+TEST(SuffixTreeRepeats, deepTree)
+{
+	// A recursive traversal would need one frame per character here
+	std::string const str(100000, 'a');
+	SuffixTree st(str);
+	std::atomic<int> count{ 0 };
+	maximalRepeats(st, [&](Repeat const&) { ++count; });
+	EXPECT_EQ(static_cast<int>(str.size()) - 1, count.load());
+}